@@ -0,0 +1,130 @@
+#pragma once
+/*
+ * Minimal Arduino core replacement for the host (native) build of the WLED render engine.
+ * Only what the effect/segment/color code needs is provided; it mimics the ESP32 Arduino core.
+ */
+#ifndef WLED_HOST_ARDUINO_H
+#define WLED_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <limits.h>
+#include <assert.h>
+#include <time.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <type_traits>
+
+#include "esp32-hal.h"
+#include "freertos/FreeRTOS.h"
+#include "WString.h"
+#include "Printable.h"
+#include "Print.h"
+#include "Stream.h"
+#include "IPAddress.h"
+
+typedef uint8_t  byte;
+typedef bool     boolean;
+typedef uint16_t word;
+inline uint16_t makeWord(uint16_t w) { return w; }
+inline uint16_t makeWord(uint8_t h, uint8_t l) { return (h << 8) | l; }
+#define word(...) makeWord(__VA_ARGS__)
+
+#ifndef PI
+  #define PI 3.1415926535897932384626433832795
+#endif
+#ifndef M_TWOPI
+  #define M_TWOPI 6.283185307179586476925286766559
+#endif
+#define HALF_PI    1.5707963267948966192313216916398
+#define TWO_PI     6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define HIGH   0x1
+#define LOW    0x0
+#define INPUT  0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP   0x05
+#define INPUT_PULLDOWN 0x09
+
+using std::abs;
+using std::isinf;
+using std::isnan;
+using std::max;
+using std::min;
+using ::round;
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define radians(deg) ((deg)*DEG_TO_RAD)
+#define degrees(rad) ((rad)*RAD_TO_DEG)
+#define sq(x) ((x)*(x))
+
+#define lowByte(w)  ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit)            (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)             ((value) |= (1UL << (bit)))
+#define bitClear(value, bit)           ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+
+// PROGMEM is plain memory on the host
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper *>(p))
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(PSTR(s)))
+#define pgm_read_byte(addr)       (*(const uint8_t *)(addr))
+#define pgm_read_byte_near(addr)  pgm_read_byte(addr)
+#define pgm_read_word(addr)       (*(const uint16_t *)(addr))
+// tables of pointers are read with pgm_read_dword() on ESP32 (32 bit pointers), keep full pointer width on the host
+template<typename T> inline typename std::enable_if<std::is_pointer<T>::value, T>::type pgm_read_dword_host(const T *addr) { return *addr; }
+template<typename T> inline typename std::enable_if<!std::is_pointer<T>::value, uint32_t>::type pgm_read_dword_host(const T *addr) { return *(const uint32_t *)addr; }
+inline uint32_t pgm_read_dword_host(const void *addr) { return *(const uint32_t *)addr; }
+#define pgm_read_dword(addr)      pgm_read_dword_host(addr)
+#define pgm_read_float(addr)      (*(const float *)(addr))
+#define pgm_read_ptr(addr)        (*(void * const *)(addr))
+#define memcpy_P     memcpy
+#define memcmp_P     memcmp
+#define strcpy_P     strcpy
+#define strncpy_P    strncpy
+#define strcat_P     strcat
+#define strncat_P    strncat
+#define strcmp_P     strcmp
+#define strncmp_P    strncmp
+#define strcasecmp_P strcasecmp
+#define strstr_P     strstr
+#define strlen_P     strlen
+#define sprintf_P    sprintf
+#define snprintf_P   snprintf
+#define vsnprintf_P  vsnprintf
+#define printf_P     printf
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_NOINIT_ATTR
+
+size_t strlcpy(char *dst, const char *src, size_t size);
+size_t strlcat(char *dst, const char *src, size_t size);
+char *itoa(int value, char *str, int base);
+char *utoa(unsigned value, char *str, int base);
+char *ltoa(long value, char *str, int base);
+char *dtostrf(double number, signed char width, unsigned char prec, char *s);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int  digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+
+#endif
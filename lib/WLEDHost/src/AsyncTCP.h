@@ -0,0 +1,7 @@
+#pragma once
+// AsyncTCP stub for the host build
+class AsyncClient {
+  public:
+    bool connected() { return false; }
+    void close(bool = false) {}
+};
@@ -0,0 +1,23 @@
+#pragma once
+/*
+ * AsyncUDP stub for the host build.
+ */
+#include "Arduino.h"
+
+class AsyncUDPPacket {
+  public:
+    uint8_t *data() { return nullptr; }
+    size_t length() { return 0; }
+    IPAddress remoteIP() { return IPAddress(); }
+    uint16_t remotePort() { return 0; }
+    bool isMulticast() { return false; }
+};
+
+class AsyncUDP {
+  public:
+    template<typename F> void onPacket(F) {}
+    bool listen(uint16_t) { return false; }
+    bool listenMulticast(const IPAddress &, uint16_t, uint8_t = 1) { return false; }
+    size_t writeTo(const uint8_t *, size_t, const IPAddress &, uint16_t) { return 0; }
+    void close() {}
+};
@@ -0,0 +1,10 @@
+#pragma once
+// DNSServer stub for the host build
+#include "Arduino.h"
+class DNSServer {
+  public:
+    bool start(uint16_t, const String &, const IPAddress &) { return false; }
+    void processNextRequest() {}
+    void stop() {}
+    void setErrorReplyCode(int) {}
+};
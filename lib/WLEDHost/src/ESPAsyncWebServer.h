@@ -0,0 +1,78 @@
+#pragma once
+/*
+ * ESPAsyncWebServer stub for the host build: only the types referenced by WLED headers.
+ */
+#ifndef WLED_HOST_ESPASYNCWEBSERVER_H
+#define WLED_HOST_ESPASYNCWEBSERVER_H
+
+#include <functional>
+#include "Arduino.h"
+#include "AsyncTCP.h"
+
+#define CONTENT_TYPE_JSON "application/json"
+
+typedef enum {
+  HTTP_GET = 0b00000001, HTTP_POST = 0b00000010, HTTP_DELETE = 0b00000100, HTTP_PUT = 0b00001000,
+  HTTP_PATCH = 0b00010000, HTTP_HEAD = 0b00100000, HTTP_OPTIONS = 0b01000000, HTTP_ANY = 0b01111111
+} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+typedef enum { WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA } AwsEventType;
+
+class AsyncWebServerRequest {
+  public:
+    void *_tempObject = nullptr;
+    WebRequestMethodComposite method() const { return HTTP_GET; }
+    const String &url() const { return _url; }
+    void addInterestingHeader(const String &) {}
+    void send(int, const String & = String(), const String & = String()) {}
+  private:
+    String _url;
+};
+
+class AsyncWebHandler {
+  public:
+    virtual ~AsyncWebHandler() {}
+    virtual bool canHandle(AsyncWebServerRequest *) { return false; }
+    virtual void handleRequest(AsyncWebServerRequest *) {}
+    virtual void handleUpload(AsyncWebServerRequest *, const String &, size_t, uint8_t *, size_t, bool) {}
+    virtual void handleBody(AsyncWebServerRequest *, uint8_t *, size_t, size_t, size_t) {}
+    virtual bool isRequestHandlerTrivial() { return true; }
+};
+
+class AsyncWebServerResponse {
+  public:
+    virtual ~AsyncWebServerResponse() {}
+  protected:
+    int _code = 0;
+    String _contentType;
+    size_t _contentLength = 0;
+    size_t _sentLength = 0;
+};
+
+class AsyncAbstractResponse : public AsyncWebServerResponse {
+  public:
+    virtual bool _sourceValid() const { return false; }
+    virtual size_t _fillBuffer(uint8_t *, size_t) { return 0; }
+};
+
+class AsyncWebSocketClient {
+  public:
+    uint32_t id() const { return 0; }
+};
+
+class AsyncWebSocket : public AsyncWebHandler {
+  public:
+    explicit AsyncWebSocket(const String &) {}
+    size_t count() const { return 0; }
+};
+
+class AsyncWebServer {
+  public:
+    struct Config { size_t a, b, c, d; }; // request queue/heap limits, ignored
+    explicit AsyncWebServer(uint16_t port) {}
+    AsyncWebServer(uint16_t port, const Config &) {}
+    void begin() {}
+    void end() {}
+};
+
+#endif
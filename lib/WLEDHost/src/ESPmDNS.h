@@ -0,0 +1,8 @@
+#pragma once
+// mDNS stub for the host build
+#include "Arduino.h"
+class MDNSResponder {
+  public:
+    IPAddress queryHost(const String &, uint32_t = 2000) { return IPAddress(); }
+};
+extern MDNSResponder MDNS;
@@ -0,0 +1,10 @@
+#pragma once
+// Ethernet stub for the host build
+#include "WiFi.h"
+class ETHClass {
+  public:
+    IPAddress localIP() { return IPAddress(); }
+    String macAddress() { return String("00:00:00:00:00:00"); }
+    bool linkUp() { return false; }
+};
+extern ETHClass ETH;
@@ -0,0 +1,435 @@
+/*
+ * Out-of-line parts of the FastLED subset used by WLED (host build).
+ * Algorithms follow FastLED 3.6.0 so rendered frames match the firmware.
+ */
+#include "FastLED.h"
+
+#ifdef WLED_ENABLE_PARALLEL_RENDER
+thread_local uint16_t rand16seed = 1337;
+#else
+uint16_t rand16seed = 1337;
+#endif
+
+//
+// HSV -> RGB
+//
+void hsv2rgb_rainbow(const CHSV &hsv, CRGB &rgb) {
+  uint8_t hue = hsv.hue;
+  uint8_t sat = hsv.sat;
+  uint8_t val = hsv.val;
+
+  uint8_t offset8 = (hue & 0x1F) << 3; // 0..248
+  uint8_t third = scale8(offset8, (256 / 3)); // max = 85
+  uint8_t r, g, b;
+
+  if (!(hue & 0x80)) {
+    if (!(hue & 0x40)) {
+      if (!(hue & 0x20)) { r = 255 - third; g = third;       b = 0; }     // R -> O
+      else               { r = 171;         g = 85 + third;  b = 0; }     // O -> Y
+    } else {
+      if (!(hue & 0x20)) { uint8_t twothirds = scale8(offset8, ((256 * 2) / 3)); r = 171 - twothirds; g = 170 + third; b = 0; } // Y -> G
+      else               { r = 0;           g = 255 - third; b = third; } // G -> A
+    }
+  } else {
+    if (!(hue & 0x40)) {
+      if (!(hue & 0x20)) { uint8_t twothirds = scale8(offset8, ((256 * 2) / 3)); r = 0; g = 171 - twothirds; b = 85 + twothirds; } // A -> B
+      else               { r = third;       g = 0;           b = 255 - third; } // B -> P
+    } else {
+      if (!(hue & 0x20)) { r = 85 + third;  g = 0;           b = 171 - third; } // P -> K
+      else               { r = 170 + third; g = 0;           b = 85 - third; }  // K -> R
+    }
+  }
+
+  // scale down colors if desaturated and add the brightness floor
+  if (sat != 255) {
+    if (sat == 0) {
+      r = 255; g = 255; b = 255;
+    } else {
+      uint8_t desat = 255 - sat;
+      desat = scale8_video(desat, desat);
+      uint8_t satscale = 255 - desat;
+      if (r) r = scale8(r, satscale) + 1;
+      if (g) g = scale8(g, satscale) + 1;
+      if (b) b = scale8(b, satscale) + 1;
+      r += desat;
+      g += desat;
+      b += desat;
+    }
+  }
+
+  // scale everything down if value < 255
+  if (val != 255) {
+    val = scale8_video(val, val);
+    if (val == 0) {
+      r = 0; g = 0; b = 0;
+    } else {
+      if (r) r = scale8(r, val) + 1;
+      if (g) g = scale8(g, val) + 1;
+      if (b) b = scale8(b, val) + 1;
+    }
+  }
+
+  rgb.r = r; rgb.g = g; rgb.b = b;
+}
+
+void hsv2rgb_rainbow(const CHSV *phsv, CRGB *prgb, int numLeds) {
+  for (int i = 0; i < numLeds; ++i) hsv2rgb_rainbow(phsv[i], prgb[i]);
+}
+
+void hsv2rgb_raw(const CHSV &hsv, CRGB &rgb) {
+  uint8_t value = hsv.val;
+  uint8_t invsat = 255 - hsv.sat;
+  uint8_t brightness_floor = (value * invsat) / 256;
+  uint8_t color_amplitude = value - brightness_floor;
+  uint8_t section = hsv.hue / 0x40;
+  uint8_t offset = hsv.hue % 0x40;
+  uint8_t rampup = offset;
+  uint8_t rampdown = (0x40 - 1) - offset;
+  uint8_t rampup_adj   = (rampup   * color_amplitude) / (256 / 4) + brightness_floor;
+  uint8_t rampdown_adj = (rampdown * color_amplitude) / (256 / 4) + brightness_floor;
+
+  if (section) {
+    if (section == 1) { rgb.r = brightness_floor; rgb.g = rampdown_adj; rgb.b = rampup_adj; }
+    else              { rgb.r = rampup_adj; rgb.g = brightness_floor; rgb.b = rampdown_adj; }
+  } else {
+    rgb.r = rampdown_adj; rgb.g = rampup_adj; rgb.b = brightness_floor;
+  }
+}
+
+void hsv2rgb_spectrum(const CHSV &hsv, CRGB &rgb) {
+  CHSV hsv2(hsv);
+  hsv2.hue = scale8(hsv2.hue, 191);
+  hsv2rgb_raw(hsv2, rgb);
+}
+
+#define FIXFRAC8(N,D) (((N)*256)/(D))
+
+CHSV rgb2hsv_approximate(const CRGB &rgb) {
+  uint8_t r = rgb.r;
+  uint8_t g = rgb.g;
+  uint8_t b = rgb.b;
+  uint8_t h, s, v;
+
+  // find and remove desaturation
+  uint8_t desat = 255;
+  if (r < desat) desat = r;
+  if (g < desat) desat = g;
+  if (b < desat) desat = b;
+  r -= desat; g -= desat; b -= desat;
+
+  s = 255 - desat;
+  if (s != 255) s = 255 - sqrt16((255 - s) * 256); // undo 'dimming' of saturation
+
+  // shade of gray
+  if ((r + g + b) == 0) return CHSV(0, 0, 255 - s);
+
+  // scale all channels up to compensate for desaturation
+  if (s < 255) {
+    if (s == 0) s = 1;
+    uint32_t scaleup = 65535 / (s);
+    r = ((uint32_t)(r) * scaleup) / 256;
+    g = ((uint32_t)(g) * scaleup) / 256;
+    b = ((uint32_t)(b) * scaleup) / 256;
+  }
+
+  uint16_t total = r + g + b;
+
+  // scale all channels up to compensate for low values
+  if (total < 255) {
+    if (total == 0) total = 1;
+    uint32_t scaleup = 65535 / (total);
+    r = ((uint32_t)(r) * scaleup) / 256;
+    g = ((uint32_t)(g) * scaleup) / 256;
+    b = ((uint32_t)(b) * scaleup) / 256;
+  }
+
+  if (total > 255) {
+    v = 255;
+  } else {
+    v = qadd8(desat, total);
+    if (v != 255) v = sqrt16(v * 256); // undo 'dimming' of brightness
+  }
+
+  uint8_t highest = r;
+  if (g > highest) highest = g;
+  if (b > highest) highest = b;
+
+  if (highest == r) {
+    if (g == 0) {                 // Purple/Pink-Red
+      h = (HUE_PURPLE + HUE_PINK) / 2;
+      h += scale8(qsub8(r, 128), FIXFRAC8(48,128));
+    } else if ((r - g) > g) {     // Red-Orange
+      h = HUE_RED;
+      h += scale8(g, FIXFRAC8(32,85));
+    } else {                      // Orange-Yellow
+      h = HUE_ORANGE;
+      h += scale8(qsub8((g - 85) + (171 - r), 4), FIXFRAC8(32,85));
+    }
+  } else if (highest == g) {
+    if (b == 0) {                 // Yellow-Green
+      h = HUE_YELLOW;
+      uint8_t radj = scale8(qsub8(171, r), 47);
+      uint8_t gadj = scale8(qsub8(g, 171), 96);
+      uint8_t rgadj = radj + gadj;
+      h += rgadj / 2;
+    } else if ((g - b) > b) {     // Green-Aqua
+      h = HUE_GREEN;
+      h += scale8(b, FIXFRAC8(32,85));
+    } else {
+      h = HUE_AQUA;
+      h += scale8(qsub8(b, 85), FIXFRAC8(8,42));
+    }
+  } else {
+    if (r == 0) {                 // Aqua/Blue-Blue
+      h = HUE_AQUA + ((HUE_BLUE - HUE_AQUA) / 4);
+      h += scale8(qsub8(b, 128), FIXFRAC8(24,128));
+    } else if ((b - r) > r) {     // Blue-Purple
+      h = HUE_BLUE;
+      h += scale8(r, FIXFRAC8(32,85));
+    } else {                      // Purple-Pink
+      h = HUE_PURPLE;
+      h += scale8(qsub8(r, 85), FIXFRAC8(32,85));
+    }
+  }
+
+  h += 1;
+  return CHSV(h, s, v);
+}
+
+//
+// fills
+//
+CRGB HeatColor(uint8_t temperature) {
+  CRGB heatcolor;
+  uint8_t t192 = scale8_video(temperature, 191);
+  uint8_t heatramp = (t192 & 0x3F) << 2; // 0..252
+  if (t192 & 0x80)      { heatcolor.r = 255;      heatcolor.g = 255;      heatcolor.b = heatramp; } // hottest
+  else if (t192 & 0x40) { heatcolor.r = 255;      heatcolor.g = heatramp; heatcolor.b = 0; }        // middle
+  else                  { heatcolor.r = heatramp; heatcolor.g = 0;        heatcolor.b = 0; }        // coolest
+  return heatcolor;
+}
+
+void fill_rainbow(CRGB *targetArray, int numToFill, uint8_t initialhue, uint8_t deltahue) {
+  CHSV hsv(initialhue, 240, 255);
+  for (int i = 0; i < numToFill; ++i) {
+    targetArray[i] = hsv;
+    hsv.hue += deltahue;
+  }
+}
+
+void fill_gradient_RGB(CRGB *leds, uint16_t startpos, CRGB startcolor, uint16_t endpos, CRGB endcolor) {
+  if (endpos < startpos) {
+    std::swap(endpos, startpos);
+    std::swap(endcolor, startcolor);
+  }
+  int16_t rdistance87 = (endcolor.r - startcolor.r) << 7;
+  int16_t gdistance87 = (endcolor.g - startcolor.g) << 7;
+  int16_t bdistance87 = (endcolor.b - startcolor.b) << 7;
+
+  uint16_t pixeldistance = endpos - startpos;
+  int16_t divisor = pixeldistance ? pixeldistance : 1;
+
+  int16_t rdelta87 = (rdistance87 / divisor) * 2;
+  int16_t gdelta87 = (gdistance87 / divisor) * 2;
+  int16_t bdelta87 = (bdistance87 / divisor) * 2;
+
+  accum88 r88 = startcolor.r << 8;
+  accum88 g88 = startcolor.g << 8;
+  accum88 b88 = startcolor.b << 8;
+  for (uint16_t i = startpos; i <= endpos; ++i) {
+    leds[i] = CRGB(r88 >> 8, g88 >> 8, b88 >> 8);
+    r88 += rdelta87;
+    g88 += gdelta87;
+    b88 += bdelta87;
+  }
+}
+
+void fill_gradient_RGB(CRGB *leds, uint16_t numLeds, const CRGB &c1, const CRGB &c2) {
+  fill_gradient_RGB(leds, 0, c1, numLeds - 1, c2);
+}
+
+void fill_gradient_RGB(CRGB *leds, uint16_t numLeds, const CRGB &c1, const CRGB &c2, const CRGB &c3) {
+  uint16_t half = (numLeds / 2);
+  uint16_t last = numLeds - 1;
+  fill_gradient_RGB(leds, 0, c1, half, c2);
+  fill_gradient_RGB(leds, half, c2, last, c3);
+}
+
+void fill_gradient_RGB(CRGB *leds, uint16_t numLeds, const CRGB &c1, const CRGB &c2, const CRGB &c3, const CRGB &c4) {
+  uint16_t onethird = (numLeds / 3);
+  uint16_t twothirds = ((numLeds * 2) / 3);
+  uint16_t last = numLeds - 1;
+  fill_gradient_RGB(leds, 0, c1, onethird, c2);
+  fill_gradient_RGB(leds, onethird, c2, twothirds, c3);
+  fill_gradient_RGB(leds, twothirds, c3, last, c4);
+}
+
+void fill_gradient(CRGB *leds, uint16_t startpos, CHSV startcolor, uint16_t endpos, CHSV endcolor, TGradientDirectionCode directionCode) {
+  if (endpos < startpos) {
+    std::swap(endpos, startpos);
+    std::swap(endcolor, startcolor);
+  }
+
+  // fading toward black (val=0) or white (sat=0) keeps the hue
+  if (endcolor.value == 0 || endcolor.saturation == 0) endcolor.hue = startcolor.hue;
+  if (startcolor.value == 0 || startcolor.saturation == 0) startcolor.hue = endcolor.hue;
+
+  int16_t huedistance87;
+  int16_t satdistance87 = (endcolor.sat - startcolor.sat) << 7;
+  int16_t valdistance87 = (endcolor.val - startcolor.val) << 7;
+
+  uint8_t huedelta8 = endcolor.hue - startcolor.hue;
+  if (directionCode == SHORTEST_HUES) directionCode = huedelta8 > 127 ? BACKWARD_HUES : FORWARD_HUES;
+  if (directionCode == LONGEST_HUES)  directionCode = huedelta8 < 128 ? BACKWARD_HUES : FORWARD_HUES;
+  if (directionCode == FORWARD_HUES) huedistance87 = huedelta8 << 7;
+  else                               huedistance87 = -(int16_t)((uint8_t)(256 - huedelta8) << 7);
+
+  uint16_t pixeldistance = endpos - startpos;
+  int16_t divisor = pixeldistance ? pixeldistance : 1;
+
+  int16_t huedelta87 = (huedistance87 / divisor) * 2;
+  int16_t satdelta87 = (satdistance87 / divisor) * 2;
+  int16_t valdelta87 = (valdistance87 / divisor) * 2;
+
+  accum88 hue88 = startcolor.hue << 8;
+  accum88 sat88 = startcolor.sat << 8;
+  accum88 val88 = startcolor.val << 8;
+  for (uint16_t i = startpos; i <= endpos; ++i) {
+    leds[i] = CHSV(hue88 >> 8, sat88 >> 8, val88 >> 8);
+    hue88 += huedelta87;
+    sat88 += satdelta87;
+    val88 += valdelta87;
+  }
+}
+
+void fill_gradient(CRGB *leds, uint16_t numLeds, const CHSV &c1, const CHSV &c2, TGradientDirectionCode directionCode) {
+  fill_gradient(leds, 0, c1, numLeds - 1, c2, directionCode);
+}
+
+void fill_gradient(CRGB *leds, uint16_t numLeds, const CHSV &c1, const CHSV &c2, const CHSV &c3, TGradientDirectionCode directionCode) {
+  uint16_t half = (numLeds / 2);
+  uint16_t last = numLeds - 1;
+  fill_gradient(leds, 0, c1, half, c2, directionCode);
+  fill_gradient(leds, half, c2, last, c3, directionCode);
+}
+
+void fill_gradient(CRGB *leds, uint16_t numLeds, const CHSV &c1, const CHSV &c2, const CHSV &c3, const CHSV &c4, TGradientDirectionCode directionCode) {
+  uint16_t onethird = (numLeds / 3);
+  uint16_t twothirds = ((numLeds * 2) / 3);
+  uint16_t last = numLeds - 1;
+  fill_gradient(leds, 0, c1, onethird, c2, directionCode);
+  fill_gradient(leds, onethird, c2, twothirds, c3, directionCode);
+  fill_gradient(leds, twothirds, c3, last, c4, directionCode);
+}
+
+//
+// palettes
+//
+CRGBPalette16 &CRGBPalette16::loadDynamicGradientPalette(TDynamicRGBGradientPalette_bytes gpal) {
+  const TRGBGradientPaletteEntryUnion *ent = reinterpret_cast<const TRGBGradientPaletteEntryUnion*>(gpal);
+  TRGBGradientPaletteEntryUnion u;
+
+  // count entries
+  uint16_t count = 0;
+  do {
+    u = *(ent + count);
+    ++count;
+  } while (u.index != 255);
+
+  int8_t lastSlotUsed = -1;
+
+  u = *ent;
+  CRGB rgbstart(u.r, u.g, u.b);
+
+  int indexstart = 0;
+  while (indexstart < 255) {
+    ++ent;
+    u = *ent;
+    int indexend = u.index;
+    CRGB rgbend(u.r, u.g, u.b);
+    uint8_t istart8 = indexstart / 16;
+    uint8_t iend8   = indexend   / 16;
+    if (count < 16) {
+      if ((istart8 <= lastSlotUsed) && (lastSlotUsed < 15)) {
+        istart8 = lastSlotUsed + 1;
+        if (iend8 < istart8) iend8 = istart8;
+      }
+      lastSlotUsed = iend8;
+    }
+    fill_gradient_RGB(&(entries[0]), istart8, rgbstart, iend8, rgbend);
+    indexstart = indexend;
+    rgbstart = rgbend;
+  }
+  return *this;
+}
+
+void nblendPaletteTowardPalette(CRGBPalette16 &current, CRGBPalette16 &target, uint8_t maxChanges) {
+  uint8_t *p1 = reinterpret_cast<uint8_t*>(current.entries);
+  uint8_t *p2 = reinterpret_cast<uint8_t*>(target.entries);
+  uint8_t changes = 0;
+  for (unsigned i = 0; i < sizeof(current.entries); ++i) {
+    if (p1[i] == p2[i]) continue;
+    if (p1[i] < p2[i]) { ++p1[i]; ++changes; }
+    if (p1[i] > p2[i]) {
+      --p1[i]; ++changes;
+      if (p1[i] > p2[i]) --p1[i];
+    }
+    if (changes >= maxChanges) break;
+  }
+}
+
+const TProgmemRGBPalette16 CloudColors_p = {
+  CRGB::Blue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue,
+  CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue,
+  CRGB::Blue, CRGB::DarkBlue, CRGB::SkyBlue, CRGB::SkyBlue,
+  CRGB::LightBlue, CRGB::White, CRGB::LightBlue, CRGB::SkyBlue
+};
+
+const TProgmemRGBPalette16 LavaColors_p = {
+  CRGB::Black, CRGB::Maroon, CRGB::Black, CRGB::Maroon,
+  CRGB::DarkRed, CRGB::DarkRed, CRGB::Maroon, CRGB::DarkRed,
+  CRGB::DarkRed, CRGB::DarkRed, CRGB::Red, CRGB::Orange,
+  CRGB::White, CRGB::Orange, CRGB::Red, CRGB::DarkRed
+};
+
+const TProgmemRGBPalette16 OceanColors_p = {
+  CRGB::MidnightBlue, CRGB::DarkBlue, CRGB::MidnightBlue, CRGB::Navy,
+  CRGB::DarkBlue, CRGB::MediumBlue, CRGB::SeaGreen, CRGB::Teal,
+  CRGB::CadetBlue, CRGB::Blue, CRGB::DarkCyan, CRGB::CornflowerBlue,
+  CRGB::Aquamarine, CRGB::SeaGreen, CRGB::Aqua, CRGB::LightSkyBlue
+};
+
+const TProgmemRGBPalette16 ForestColors_p = {
+  CRGB::DarkGreen, CRGB::DarkGreen, CRGB::DarkOliveGreen, CRGB::DarkGreen,
+  CRGB::Green, CRGB::ForestGreen, CRGB::OliveDrab, CRGB::Green,
+  CRGB::SeaGreen, CRGB::MediumAquamarine, CRGB::LimeGreen, CRGB::YellowGreen,
+  CRGB::LightGreen, CRGB::LawnGreen, CRGB::MediumAquamarine, CRGB::ForestGreen
+};
+
+const TProgmemRGBPalette16 RainbowColors_p = {
+  0xFF0000, 0xD52A00, 0xAB5500, 0xAB7F00,
+  0xABAB00, 0x56D500, 0x00FF00, 0x00D52A,
+  0x00AB55, 0x0056AA, 0x0000FF, 0x2A00D5,
+  0x5500AB, 0x7F0081, 0xAB0055, 0xD5002B
+};
+
+const TProgmemRGBPalette16 RainbowStripeColors_p = {
+  0xFF0000, 0x000000, 0xAB5500, 0x000000,
+  0xABAB00, 0x000000, 0x00FF00, 0x000000,
+  0x00AB55, 0x000000, 0x0000FF, 0x000000,
+  0x5500AB, 0x000000, 0xAB0055, 0x000000
+};
+
+const TProgmemRGBPalette16 PartyColors_p = {
+  0x5500AB, 0x84007C, 0xB5004B, 0xE5001B,
+  0xE81700, 0xB84700, 0xAB7700, 0xABAB00,
+  0xAB5500, 0xDD2200, 0xF2000E, 0xC2003E,
+  0x8F0071, 0x5F00A1, 0x2F00D0, 0x0007F9
+};
+
+const TProgmemRGBPalette16 HeatColors_p = {
+  0x000000, 0x330000, 0x660000, 0x990000,
+  0xCC0000, 0xFF0000, 0xFF3300, 0xFF6600,
+  0xFF9900, 0xFFCC00, 0xFFFF00, 0xFFFF33,
+  0xFFFF66, 0xFFFF99, 0xFFFFCC, 0xFFFFFF
+};
@@ -0,0 +1,126 @@
+#pragma once
+/*
+ * In-memory PolyBus replacement for the host build (used by bus_manager.cpp instead of bus_wrapper.h).
+ * Every digital bus becomes a plain byte buffer holding the pixels in wire (color order adjusted) format,
+ * just like NeoPixelBus would, so BusDigital runs its normal per-pixel path without any hardware.
+ */
+#ifndef WLED_HOST_POLYBUS_H
+#define WLED_HOST_POLYBUS_H
+
+#include <utility>
+
+#define I_NONE   0
+#define I_HOST_3 1 // 3 channel (RGB) in-memory bus
+#define I_HOST_4 2 // 4 channel (RGBW) in-memory bus
+
+#ifndef RGBW32
+#define RGBW32(r,g,b,w) (uint32_t((byte(w) << 24) | (byte(r) << 16) | (byte(g) << 8) | (byte(b))))
+#endif
+
+struct HostBusBuffer {
+  uint16_t len;
+  uint8_t  channels;
+  uint8_t  channel;        // output channel/number (informational)
+  uint32_t showCount;      // number of show() calls
+  uint8_t  data[];         // len * channels bytes in wire order
+};
+
+// access to the raw output of a host bus (e.g. to checksum frames)
+inline const HostBusBuffer *hostBusBuffer(const void *busPtr) { return static_cast<const HostBusBuffer*>(busPtr); }
+
+class PolyBus {
+  private:
+    static bool _useParallelI2S;
+
+  public:
+    static inline void setParallelI2S1Output(bool b = true) { _useParallelI2S = b; }
+    static inline bool isParallelI2S1Output(void) { return _useParallelI2S; }
+
+    static void begin(void* busPtr, uint8_t busType, uint8_t* pins, uint16_t clock_kHz) {}
+
+    static void* create(uint8_t busType, uint8_t* pins, uint16_t len, uint8_t channel) {
+      if (busType == I_NONE) return nullptr;
+      unsigned channels = busType == I_HOST_4 ? 4 : 3;
+      HostBusBuffer *buf = static_cast<HostBusBuffer*>(calloc(1, sizeof(HostBusBuffer) + len * channels));
+      if (!buf) return nullptr;
+      buf->len = len;
+      buf->channels = channels;
+      buf->channel = channel;
+      return buf;
+    }
+
+    static void show(void* busPtr, uint8_t busType, bool consistent = true) {
+      if (busPtr) static_cast<HostBusBuffer*>(busPtr)->showCount++;
+    }
+
+    static bool canShow(void* busPtr, uint8_t busType) { return true; }
+
+    [[gnu::hot]] static void setPixelColor(void* busPtr, uint8_t busType, uint16_t pix, uint32_t c, uint8_t co, uint16_t wwcw = 0) {
+      HostBusBuffer *buf = static_cast<HostBusBuffer*>(busPtr);
+      if (!buf || pix >= buf->len) return;
+      uint8_t r = c >> 16;
+      uint8_t g = c >> 8;
+      uint8_t b = c >> 0;
+      uint8_t w = c >> 24;
+      uint8_t G, R, B, W;
+      // reorder channels to selected order
+      switch (co & 0x0F) {
+        default: G = g; R = r; B = b; break; //0 = GRB, default
+        case  1: G = r; R = g; B = b; break; //1 = RGB, common for WS2811
+        case  2: G = b; R = r; B = g; break; //2 = BRG
+        case  3: G = r; R = b; B = g; break; //3 = RBG
+        case  4: G = b; R = g; B = r; break; //4 = BGR
+        case  5: G = g; R = b; B = r; break; //5 = GBR
+      }
+      // upper nibble contains W swap information
+      switch (co >> 4) {
+        default: W = w;        break; // no swapping
+        case  1: W = B; B = w; break; // swap W & B
+        case  2: W = G; G = w; break; // swap W & G
+        case  3: W = R; R = w; break; // swap W & R
+      }
+      uint8_t *p = buf->data + pix * buf->channels; // stored as GRB(W) like NeoGrbFeature
+      p[0] = G; p[1] = R; p[2] = B;
+      if (buf->channels > 3) p[3] = W;
+    }
+
+    [[gnu::hot]] static uint32_t getPixelColor(void* busPtr, uint8_t busType, uint16_t pix, uint8_t co) {
+      const HostBusBuffer *buf = static_cast<const HostBusBuffer*>(busPtr);
+      if (!buf || pix >= buf->len) return 0;
+      const uint8_t *p = buf->data + pix * buf->channels;
+      uint8_t G = p[0], R = p[1], B = p[2], W = buf->channels > 3 ? p[3] : 0;
+      // upper nibble contains W swap information
+      uint8_t w = W;
+      switch (co >> 4) {
+        case 1: W = B; B = w; break; // swap W & B
+        case 2: W = G; G = w; break; // swap W & G
+        case 3: W = R; R = w; break; // swap W & R
+      }
+      switch (co & 0x0F) {
+        //                    W           G           R            B
+        default: return ((W << 24) | (G << 8) | (R << 16) | (B)); //0 = GRB, default
+        case  1: return ((W << 24) | (R << 8) | (G << 16) | (B)); //1 = RGB, common for WS2811
+        case  2: return ((W << 24) | (B << 8) | (R << 16) | (G)); //2 = BRG
+        case  3: return ((W << 24) | (B << 8) | (G << 16) | (R)); //3 = RBG
+        case  4: return ((W << 24) | (R << 8) | (B << 16) | (G)); //4 = BGR
+        case  5: return ((W << 24) | (G << 8) | (B << 16) | (R)); //5 = GBR
+      }
+      return 0;
+    }
+
+    static void cleanup(void* busPtr, uint8_t busType) { free(busPtr); }
+
+    static unsigned getDataSize(void* busPtr, uint8_t busType) {
+      const HostBusBuffer *buf = static_cast<const HostBusBuffer*>(busPtr);
+      return buf ? buf->len * buf->channels : 0;
+    }
+
+    static unsigned memUsage(unsigned count, unsigned busType) { return count * (busType == I_HOST_4 ? 4 : 3); }
+
+    static uint8_t getI(uint8_t busType, const uint8_t* pins, uint8_t num = 0) {
+      if (!Bus::isDigital(busType)) return I_NONE;
+      return Bus::hasWhite(busType) ? I_HOST_4 : I_HOST_3;
+    }
+};
+
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+/*
+ * Arduino IPAddress replacement for the host build.
+ */
+#ifndef WLED_HOST_IPADDRESS_H
+#define WLED_HOST_IPADDRESS_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "WString.h"
+
+class IPAddress {
+  public:
+    IPAddress() : _addr(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _addr(uint32_t(a) | uint32_t(b)<<8 | uint32_t(c)<<16 | uint32_t(d)<<24) {}
+    IPAddress(uint32_t addr) : _addr(addr) {}
+    operator uint32_t() const { return _addr; }
+    bool operator==(const IPAddress &o) const { return _addr == o._addr; }
+    bool operator!=(const IPAddress &o) const { return _addr != o._addr; }
+    uint8_t operator[](int i) const { return _addr >> (8*i); }
+    uint8_t &operator[](int i) { return reinterpret_cast<uint8_t*>(&_addr)[i]; }
+    IPAddress &operator=(uint32_t addr) { _addr = addr; return *this; }
+    bool fromString(const char *) { return false; }
+    String toString() const {
+      char buf[16];
+      snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+      return String(buf);
+    }
+  private:
+    uint32_t _addr;
+};
+
+#define INADDR_NONE IPAddress(0,0,0,0)
+
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+/*
+ * LittleFS replacement for the host build: files are read from and written to a host directory
+ * (current working directory by default, see hostSetFsRoot()).
+ */
+#ifndef WLED_HOST_LITTLEFS_H
+#define WLED_HOST_LITTLEFS_H
+
+#include <stdio.h>
+#include "Arduino.h"
+
+void hostSetFsRoot(const char *path);
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+class File : public Stream {
+  public:
+    File() : _f(nullptr) {}
+    explicit File(FILE *f, const char *name = "") : _f(f), _name(name) {}
+    size_t write(uint8_t c) override { return _f ? fwrite(&c, 1, 1, _f) : 0; }
+    size_t write(const uint8_t *buf, size_t size) override { return _f ? fwrite(buf, 1, size, _f) : 0; }
+    using Print::write;
+    int available() override { if (!_f) return 0; long p = ftell(_f); fseek(_f, 0, SEEK_END); long e = ftell(_f); fseek(_f, p, SEEK_SET); return e - p; }
+    int read() override { if (!_f) return -1; int c = fgetc(_f); return c == EOF ? -1 : c; }
+    size_t read(uint8_t *buf, size_t size) { return _f ? fread(buf, 1, size, _f) : 0; }
+    int peek() override { if (!_f) return -1; int c = fgetc(_f); if (c != EOF) ungetc(c, _f); return c == EOF ? -1 : c; }
+    void flush() override { if (_f) fflush(_f); }
+    bool seek(uint32_t pos, SeekMode mode = SeekSet) { return _f && fseek(_f, pos, mode) == 0; }
+    size_t position() const { return _f ? ftell(_f) : 0; }
+    size_t size() const { if (!_f) return 0; long p = ftell(_f); fseek(_f, 0, SEEK_END); long e = ftell(_f); fseek(_f, p, SEEK_SET); return e; }
+    void close() { if (_f) fclose(_f); _f = nullptr; }
+    const char *name() const { return _name.c_str(); }
+    bool isDirectory() const { return false; }
+    operator bool() const { return _f != nullptr; }
+  private:
+    FILE *_f;
+    String _name;
+};
+
+class FS {
+  public:
+    bool begin(bool = false) { return true; }
+    File open(const char *path, const char *mode = "r");
+    File open(const String &path, const char *mode = "r") { return open(path.c_str(), mode); }
+    bool exists(const char *path);
+    bool exists(const String &path) { return exists(path.c_str()); }
+    bool remove(const char *path);
+    bool remove(const String &path) { return remove(path.c_str()); }
+    bool rename(const char *from, const char *to);
+    size_t totalBytes() { return 1024*1024; }
+    size_t usedBytes() { return 0; }
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+extern fs::FS LittleFS;
+#define FILE_READ  "r"
+#define FILE_WRITE "w"
+
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+/*
+ * Arduino Print/HardwareSerial replacement for the host build (Serial writes to stdout).
+ */
+#ifndef WLED_HOST_PRINT_H
+#define WLED_HOST_PRINT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) { size_t n = 0; while (size--) n += write(*buffer++); return n; }
+    size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+    virtual void flush() {}
+
+    size_t printf(const char *format, ...) __attribute__ ((format (printf, 2, 3)));
+    size_t print(const __FlashStringHelper *s) { return write(reinterpret_cast<const char*>(s)); }
+    size_t print(const String &s)  { return write(s.c_str()); }
+    size_t print(const char *s)    { return write(s); }
+    size_t print(char c)           { return write((uint8_t)c); }
+    size_t print(unsigned char v, int base = DEC)  { return print((unsigned long)v, base); }
+    size_t print(int v, int base = DEC)            { return print((long)v, base); }
+    size_t print(unsigned v, int base = DEC)       { return print((unsigned long)v, base); }
+    size_t print(long v, int base = DEC);
+    size_t print(unsigned long v, int base = DEC);
+    size_t print(long long v, int base = DEC)          { return print((long)v, base); }
+    size_t print(unsigned long long v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(double v, int digits = 2);
+    template<typename T> size_t println(const T &v) { size_t n = print(v); return n + println(); }
+    template<typename T> size_t println(const T &v, int f) { size_t n = print(v, f); return n + println(); }
+    size_t println() { return write("\r\n"); }
+};
+
+class HardwareSerial : public Print {
+  public:
+    void begin(unsigned long) {}
+    void end() {}
+    int available() { return 0; }
+    int read() { return -1; }
+    int peek() { return -1; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+#endif
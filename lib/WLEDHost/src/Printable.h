@@ -0,0 +1,8 @@
+#pragma once
+// Arduino Printable interface (host build)
+class Print;
+class Printable {
+  public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print &p) const = 0;
+};
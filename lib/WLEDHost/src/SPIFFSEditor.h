@@ -0,0 +1,3 @@
+#pragma once
+// SPIFFSEditor stub for the host build (matches the Aircoookie ESPAsyncWebServer fork)
+#define SPIFFS_EDITOR_AIRCOOOKIE
@@ -0,0 +1,31 @@
+#pragma once
+/*
+ * Arduino Stream replacement for the host build.
+ */
+#ifndef WLED_HOST_STREAM_H
+#define WLED_HOST_STREAM_H
+
+#include "Print.h"
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    size_t readBytes(uint8_t *buffer, size_t length) { size_t n = 0; int c; while (n < length && (c = read()) >= 0) buffer[n++] = c; return n; }
+    size_t readBytes(char *buffer, size_t length) { return readBytes((uint8_t *)buffer, length); }
+    size_t readBytesUntil(char terminator, char *buffer, size_t length) {
+      size_t n = 0; int c;
+      while (n < length && (c = read()) >= 0 && c != terminator) buffer[n++] = c;
+      return n;
+    }
+    bool find(const char *target) {
+      size_t len = strlen(target), idx = 0; int c;
+      if (!len) return true;
+      while ((c = read()) >= 0) { if (c == target[idx]) { if (++idx == len) return true; } else idx = (c == target[0]); }
+      return false;
+    }
+    void setTimeout(unsigned long) {}
+};
+
+#endif
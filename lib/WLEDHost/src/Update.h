@@ -0,0 +1,8 @@
+#pragma once
+// OTA Update stub for the host build
+class UpdateClass {
+  public:
+    bool canRollBack() { return false; }
+    bool rollBack() { return false; }
+};
+extern UpdateClass Update;
@@ -0,0 +1,92 @@
+#pragma once
+/*
+ * Arduino String replacement for the host build, backed by std::string.
+ */
+#ifndef WLED_HOST_WSTRING_H
+#define WLED_HOST_WSTRING_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+
+class __FlashStringHelper;
+
+class String {
+  public:
+    String() = default;
+    String(const char *s) : _s(s ? s : "") {}
+    String(const __FlashStringHelper *s) : _s(s ? reinterpret_cast<const char*>(s) : "") {}
+    String(const std::string &s) : _s(s) {}
+    explicit String(char c) : _s(1, c) {}
+    explicit String(int v, unsigned char base = 10)           { fromNumber((long long)v, base); }
+    explicit String(unsigned v, unsigned char base = 10)      { fromNumber((long long)v, base); }
+    explicit String(long v, unsigned char base = 10)          { fromNumber((long long)v, base); }
+    explicit String(unsigned long v, unsigned char base = 10) { fromNumber((long long)v, base); }
+    explicit String(float v, unsigned char decimals = 2)      { fromFloat(v, decimals); }
+    explicit String(double v, unsigned char decimals = 2)     { fromFloat(v, decimals); }
+
+    unsigned int length() const   { return _s.length(); }
+    bool isEmpty() const          { return _s.empty(); }
+    const char *c_str() const     { return _s.c_str(); }
+    char *begin()                 { return &_s[0]; }
+    char *end()                   { return &_s[0] + _s.length(); }
+    bool reserve(unsigned int n)  { _s.reserve(n); return true; }
+    char charAt(unsigned int i) const { return i < _s.length() ? _s[i] : 0; }
+    char operator[](unsigned int i) const { return charAt(i); }
+    char &operator[](unsigned int i) { return _s[i]; }
+    void setCharAt(unsigned int i, char c) { if (i < _s.length()) _s[i] = c; }
+
+    String &operator+=(const String &o)  { _s += o._s; return *this; }
+    String &operator+=(const char *o)    { if (o) _s += o; return *this; }
+    String &operator+=(const __FlashStringHelper *o) { return *this += reinterpret_cast<const char*>(o); }
+    String &operator+=(char c)           { _s += c; return *this; }
+    String &operator+=(int v)            { return *this += String(v); }
+    String &operator+=(unsigned v)       { return *this += String(v); }
+    String &operator+=(long v)           { return *this += String(v); }
+    String &operator+=(unsigned long v)  { return *this += String(v); }
+    bool concat(const String &o)         { _s += o._s; return true; }
+    bool concat(const char *o)           { if (o) _s += o; return true; }
+    bool concat(char c)                  { _s += c; return true; }
+
+    bool operator==(const String &o) const { return _s == o._s; }
+    bool operator==(const char *o) const   { return o && _s == o; }
+    bool operator!=(const String &o) const { return _s != o._s; }
+    bool operator!=(const char *o) const   { return !(*this == o); }
+    bool operator<(const String &o) const  { return _s < o._s; }
+    bool equals(const String &o) const     { return _s == o._s; }
+    bool equalsIgnoreCase(const String &o) const;
+    bool startsWith(const String &p) const { return _s.compare(0, p._s.length(), p._s) == 0; }
+    bool endsWith(const String &p) const   { return _s.length() >= p._s.length() && _s.compare(_s.length()-p._s.length(), p._s.length(), p._s) == 0; }
+
+    int indexOf(char c, unsigned int from = 0) const           { size_t p = _s.find(c, from); return p == std::string::npos ? -1 : int(p); }
+    int indexOf(const String &s, unsigned int from = 0) const  { size_t p = _s.find(s._s, from); return p == std::string::npos ? -1 : int(p); }
+    int lastIndexOf(char c) const                              { size_t p = _s.rfind(c); return p == std::string::npos ? -1 : int(p); }
+    String substring(unsigned int from) const                  { return from < _s.length() ? String(_s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const { if (from > to) std::swap(from, to); return from < _s.length() ? String(_s.substr(from, to-from)) : String(); }
+    void replace(const String &f, const String &r);
+    void remove(unsigned int index, unsigned int count = (unsigned)-1) { if (index < _s.length()) _s.erase(index, count); }
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+    long toInt() const     { return strtol(_s.c_str(), nullptr, 10); }
+    float toFloat() const  { return strtof(_s.c_str(), nullptr); }
+
+    friend String operator+(const String &a, const String &b) { String r(a); r += b; return r; }
+    friend String operator+(const String &a, const char *b)   { String r(a); r += b; return r; }
+    friend String operator+(const char *a, const String &b)   { String r(a); r += b; return r; }
+    friend String operator+(const String &a, char b)          { String r(a); r += b; return r; }
+
+  private:
+    void fromNumber(long long v, unsigned char base);
+    void fromFloat(double v, unsigned char decimals);
+    std::string _s;
+};
+
+// ArduinoJson detects Arduino String support through this type
+class StringSumHelper : public String {
+  public:
+    StringSumHelper(const String &s) : String(s) {}
+    StringSumHelper(const char *p) : String(p) {}
+};
+
+#endif
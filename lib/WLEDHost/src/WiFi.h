@@ -0,0 +1,38 @@
+#pragma once
+/*
+ * WiFi stub for the host build: the render engine never touches the network.
+ */
+#ifndef WLED_HOST_WIFI_H
+#define WLED_HOST_WIFI_H
+
+#include "Arduino.h"
+
+typedef enum { WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL, WL_SCAN_COMPLETED, WL_CONNECTED, WL_CONNECT_FAILED, WL_CONNECTION_LOST, WL_DISCONNECTED } wl_status_t;
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } WiFiMode_t;
+#define WIFI_MODE_STA WIFI_STA
+#define WIFI_MODE_AP  WIFI_AP
+typedef enum { WIFI_POWER_19_5dBm = 78, WIFI_POWER_8_5dBm = 34 } wifi_power_t;
+typedef int WiFiEvent_t;
+typedef int arduino_event_id_t;
+
+class WiFiClass {
+  public:
+    wl_status_t status() { return WL_DISCONNECTED; }
+    IPAddress localIP() { return IPAddress(); }
+    IPAddress softAPIP() { return IPAddress(); }
+    IPAddress subnetMask() { return IPAddress(); }
+    IPAddress gatewayIP() { return IPAddress(); }
+    String macAddress() { return String("00:00:00:00:00:00"); }
+    uint8_t *macAddress(uint8_t *mac) { for (int i = 0; i < 6; i++) mac[i] = 0; return mac; }
+    String SSID() { return String(); }
+    int32_t RSSI() { return 0; }
+    int32_t channel() { return 0; }
+    WiFiMode_t getMode() { return WIFI_OFF; }
+    bool mode(WiFiMode_t) { return true; }
+    uint8_t softAPgetStationNum() { return 0; }
+    bool isConnected() { return false; }
+    int hostByName(const char *, IPAddress &) { return 0; }
+};
+extern WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+/*
+ * WiFiUDP stub for the host build.
+ */
+#ifndef WLED_HOST_WIFIUDP_H
+#define WLED_HOST_WIFIUDP_H
+
+#include "Arduino.h"
+
+class WiFiUDP : public Stream {
+  public:
+    uint8_t begin(uint16_t) { return 0; }
+    uint8_t beginMulticast(IPAddress, uint16_t) { return 0; }
+    void stop() {}
+    int beginPacket(IPAddress, uint16_t) { return 0; }
+    int beginPacket(const char *, uint16_t) { return 0; }
+    int endPacket() { return 0; }
+    size_t write(uint8_t) override { return 1; }
+    size_t write(const uint8_t *, size_t size) override { return size; }
+    using Print::write;
+    int parsePacket() { return 0; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int read(unsigned char *, size_t) { return 0; }
+    int read(char *, size_t) { return 0; }
+    int peek() override { return -1; }
+    void flush() override {}
+    IPAddress remoteIP() { return IPAddress(); }
+    uint16_t remotePort() { return 0; }
+};
+
+#endif
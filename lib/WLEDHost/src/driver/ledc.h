@@ -0,0 +1,16 @@
+#pragma once
+/*
+ * LEDC driver stub for the host build (classic ESP32 channel layout), PWM output goes nowhere.
+ */
+#include <stdint.h>
+#define LEDC_CHANNEL_MAX    8
+#define LEDC_SPEED_MODE_MAX 2
+typedef int ledc_mode_t;
+typedef int ledc_timer_t;
+typedef int ledc_channel_t;
+inline int ledc_timer_rst(ledc_mode_t, ledc_timer_t) { return 0; }
+inline int ledc_update_duty(ledc_mode_t, ledc_channel_t) { return 0; }
+inline uint32_t ledcSetup(uint8_t, uint32_t freq, uint8_t) { return freq; }
+inline void ledcAttachPin(uint8_t, uint8_t) {}
+inline void ledcDetachPin(uint8_t) {}
+inline void ledcWrite(uint8_t, uint32_t) {}
@@ -0,0 +1,97 @@
+#pragma once
+/*
+ * Host replacements for the ESP32 HAL/IDF functions used by the render engine.
+ * Time is taken from the monotonic host clock unless a virtual clock is selected (see host_time.cpp),
+ * memory comes from the C library heap.
+ */
+#ifndef WLED_HOST_ESP32_HAL_H
+#define WLED_HOST_ESP32_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#define ESP_IDF_VERSION_VAL(major, minor, patch) ((major << 16) | (minor << 8) | (patch))
+#define ESP_IDF_VERSION ESP_IDF_VERSION_VAL(4, 4, 0)
+
+// the host heap is treated as one large DRAM region
+#define SOC_DRAM_LOW        ((uintptr_t)0)
+#define SOC_DRAM_HIGH       UINTPTR_MAX
+#define SOC_EXTRAM_DATA_LOW  ((uintptr_t)0)
+#define SOC_EXTRAM_DATA_HIGH ((uintptr_t)0)
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// virtual clock: when enabled millis()/micros() only move when advanced explicitly (reproducible benchmarks and frame replay)
+void hostUseVirtualClock(bool enable);
+void hostAdvanceClock(uint32_t us);
+
+// heap_caps_* allocator emulation (there is only one heap on the host)
+#define MALLOC_CAP_EXEC     (1<<0)
+#define MALLOC_CAP_32BIT    (1<<1)
+#define MALLOC_CAP_8BIT     (1<<2)
+#define MALLOC_CAP_DMA      (1<<3)
+#define MALLOC_CAP_SPIRAM   (1<<10)
+#define MALLOC_CAP_INTERNAL (1<<11)
+#define MALLOC_CAP_DEFAULT  (1<<12)
+#define MALLOC_CAP_RTCRAM   (1<<15)
+
+void  *heap_caps_malloc(size_t size, uint32_t caps);
+void  *heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+void  *heap_caps_realloc(void *ptr, size_t size, uint32_t caps);
+void  *heap_caps_malloc_prefer(size_t size, size_t num, ...);
+void  *heap_caps_realloc_prefer(void *ptr, size_t size, size_t num, ...);
+void   heap_caps_free(void *ptr);
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+inline bool psramFound() { return false; }
+inline void *ps_malloc(size_t size) { return heap_caps_malloc(size, MALLOC_CAP_SPIRAM); }
+inline void *ps_calloc(size_t n, size_t size) { return heap_caps_calloc(n, size, MALLOC_CAP_SPIRAM); }
+inline void *ps_realloc(void *ptr, size_t size) { return heap_caps_realloc(ptr, size, MALLOC_CAP_SPIRAM); }
+
+// bookkeeping of memory allocated through heap_caps_*() (i.e. everything WLED allocates via d_malloc()/p_malloc())
+typedef struct {
+  size_t   used;   // bytes currently allocated
+  size_t   peak;   // high-water mark of used since last hostResetHeapPeak()
+  uint32_t allocs; // number of successful allocations
+} host_heap_stats_t;
+host_heap_stats_t hostHeapStats();
+void hostResetHeapPeak();
+
+typedef enum {
+  ESP_RST_UNKNOWN, ESP_RST_POWERON, ESP_RST_EXT, ESP_RST_SW, ESP_RST_PANIC, ESP_RST_INT_WDT,
+  ESP_RST_TASK_WDT, ESP_RST_WDT, ESP_RST_DEEPSLEEP, ESP_RST_BROWNOUT, ESP_RST_SDIO
+} esp_reset_reason_t;
+inline esp_reset_reason_t esp_reset_reason() { return ESP_RST_POWERON; }
+uint64_t esp_rtc_get_time_us();
+int64_t  esp_timer_get_time();
+uint32_t esp_random();
+
+#define REG_READ(reg) esp_random()
+#define WDEV_RND_REG 0
+
+#define GPIO_PIN_COUNT 40 // pretend to be a classic ESP32
+#define digitalPinIsValid(pin)   ((pin) < GPIO_PIN_COUNT && (pin) != 20 && (pin) != 24 && ((pin) < 28 || (pin) > 31))
+#define digitalPinCanOutput(pin) (digitalPinIsValid(pin) && (pin) < 34)
+
+class EspClass {
+  public:
+    uint32_t getFreeHeap()         { return heap_caps_get_free_size(MALLOC_CAP_DEFAULT); }
+    uint32_t getMaxAllocHeap()     { return heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT); }
+    uint32_t getMaxFreeBlockSize() { return heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT); }
+    uint32_t getHeapSize()         { return 320*1024; }
+    uint32_t getPsramSize()        { return 0; }
+    uint32_t getFreePsram()        { return 0; }
+    uint32_t getCpuFreqMHz()       { return 240; }
+    uint32_t getFlashChipSize()    { return 4*1024*1024; }
+    const char *getSdkVersion()    { return "host"; }
+    const char *getChipModel()     { return "ESP32-D0WD-V3"; }
+    void restart();
+};
+extern EspClass ESP;
+
+#endif
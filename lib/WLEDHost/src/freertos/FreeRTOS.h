@@ -0,0 +1,49 @@
+#pragma once
+/*
+ * FreeRTOS replacement for the host build: (recursive) mutexes map onto std::recursive_timed_mutex,
+ * binary semaphores onto a flag with a condition variable, tasks onto std::thread.
+ */
+#ifndef WLED_HOST_FREERTOS_H
+#define WLED_HOST_FREERTOS_H
+
+#include <stdint.h>
+#include <atomic>
+
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+#define pdFALSE 0
+#define pdTRUE  1
+#define pdPASS  pdTRUE
+#define pdFAIL  pdFALSE
+#define portMAX_DELAY     0xFFFFFFFFUL
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define tskNO_AFFINITY    0x7FFFFFFF
+
+typedef void *SemaphoreHandle_t;
+typedef SemaphoreHandle_t xSemaphoreHandle;
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex();
+SemaphoreHandle_t xSemaphoreCreateMutex();
+SemaphoreHandle_t xSemaphoreCreateBinary(); // created empty (must be given before it can be taken)
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t sem);
+#define xSemaphoreTake xSemaphoreTakeRecursive
+#define xSemaphoreGive xSemaphoreGiveRecursive
+void vSemaphoreDelete(SemaphoreHandle_t sem);
+
+// critical sections are spinlocks (there are no interrupts to disable)
+typedef struct { std::atomic_flag flag; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED { ATOMIC_FLAG_INIT }
+#define portENTER_CRITICAL(mux) do { while ((mux)->flag.test_and_set(std::memory_order_acquire)) ; } while (0)
+#define portEXIT_CRITICAL(mux)  (mux)->flag.clear(std::memory_order_release)
+
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *param, UBaseType_t prio, TaskHandle_t *handle, BaseType_t core);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+BaseType_t xPortGetCoreID();
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * Host (native) build: per-effect benchmark.
+ *
+ * Renders every effect on a fixed set of strip shapes and writes one JSON object per line
+ * (effect, shape, render time per frame and per pixel, heap used by the effect) so results can be
+ * compared between commits, e.g. with: wled_host -b -f 200 > bench.jsonl
+ *
+ * hostBusBenchmark() times pixel routing in BusManager (wled_host -B).
+ */
+#include <chrono>
+#include "wled.h"
+#include "host_engine.h"
+
+typedef struct {
+  const char *name;
+  uint16_t    leds;   // 1D length (width*height for matrices)
+  uint8_t     width;  // 0 for 1D
+  uint8_t     height;
+  int8_t      m12;    // map1D2D mapping for 1D effects on a matrix, -1 for native 1D/2D
+} bench_shape_t;
+
+static const bench_shape_t shapes[] = {
+  {"1D",      300,  0,  0, -1},
+  {"1D",     1500,  0,  0, -1},
+  {"1D",     6000,  0,  0, -1},
+  {"2D",      256, 16, 16, -1},
+  {"2D",     1024, 32, 32, -1},
+  {"2D",     4096, 64, 64, -1},
+  {"1Don2D", 1024, 32, 32, M12_Pixels},
+  {"1Don2D", 1024, 32, 32, M12_pBar},
+  {"1Don2D", 1024, 32, 32, M12_pArc},
+  {"1Don2D", 1024, 32, 32, M12_pCorner},
+  {"1Don2D", 1024, 32, 32, M12_sPinwheel},
+};
+
+// returns the flags field of the effect metadata ("Name@sliders;colors;palette;flags;defaults")
+static void getModeFlags(uint8_t mode, char *dest, size_t maxLen) {
+  const char *p = strchr(strip.getModeData(mode), '@');
+  dest[0] = '\0';
+  for (unsigned field = 0; p && field < 3; field++) p = strchr(p + 1, ';');
+  if (!p) return;
+  size_t len = strcspn(++p, ";");
+  if (len >= maxLen) len = maxLen - 1;
+  memcpy(dest, p, len);
+  dest[len] = '\0';
+}
+
+int hostBenchmark(unsigned frames, bool rgbw, FILE *out) {
+  unsigned runs = 0;
+  for (const auto &shape : shapes) {
+    const bool matrix = shape.width && shape.height;
+    for (unsigned fx = 0; fx < strip.getModeCount(); fx++) {
+      const char *data = strip.getModeData(fx);
+      if (strncmp_P("RSVD", data, 4) == 0) continue;
+      char flags[8];
+      getModeFlags(fx, flags, sizeof(flags));
+      const bool is2D = strchr(flags, '2') != nullptr;
+      const bool is1D = !is2D || strchr(flags, '1') != nullptr; // no flags means 1D only
+      if (matrix && shape.m12 < 0 ? !is2D : !is1D) continue;
+
+      hostSetupStrip(shape.leds, shape.width, shape.height, rgbw, WLED_FPS); // fresh strip and segment for each run
+      Segment &seg = strip.getMainSegment();
+      seg.setMode(fx, true);
+      if (shape.m12 >= 0) seg.map1D2D = shape.m12;
+      const host_heap_stats_t before = hostHeapStats();
+      hostResetHeapPeak();
+      const host_run_result_t res = hostRunFrames(frames, false);
+      const host_heap_stats_t after = hostHeapStats();
+
+      const unsigned pixels = strip.getLengthTotal();
+      fprintf(out, "{\"fx\":%u,\"name\":\"%.*s\",\"shape\":\"%s\",\"w\":%u,\"h\":%u,\"leds\":%u,\"m12\":%d,"
+                   "\"frames\":%u,\"shown\":%u,\"us_per_frame\":%.2f,\"ns_per_px_frame\":%.2f,"
+                   "\"heap_peak\":%u,\"heap_allocs\":%u,\"data\":%u,\"seg_data_total\":%u}\n",
+        fx, (int)strcspn(data, "@"), data, shape.name, (unsigned)Segment::maxWidth, (unsigned)Segment::maxHeight, pixels, (int)shape.m12,
+        frames, res.shown, frames ? res.renderNs / 1e3 / frames : 0.0, frames && pixels ? (double)res.renderNs / frames / pixels : 0.0,
+        (unsigned)(after.peak - before.used), after.allocs - before.allocs, (unsigned)seg.dataSize(), Segment::getUsedSegmentData());
+      runs++;
+    }
+  }
+  return runs;
+}
+
+//
+// bus routing microbenchmark
+//
+static const uint8_t busCounts[] = {1, 4, 8, 10};
+#define BUS_BENCH_LEDS 2000
+
+// linear scan over all buses (BusManager routing before the routing table) as reference
+static void scanSetPixelColor(unsigned pix, uint32_t c) {
+  for (auto &bus : BusManager::busses) {
+    if (!bus->containsPixel(pix)) continue;
+    bus->setPixelColor(pix - bus->getStart(), c);
+  }
+}
+
+static uint32_t scanGetPixelColor(unsigned pix) {
+  for (auto &bus : BusManager::busses) {
+    if (!bus->containsPixel(pix)) continue;
+    return bus->getPixelColor(pix - bus->getStart());
+  }
+  return 0;
+}
+
+template<typename Fn>
+static double nsPerPixel(unsigned rounds, Fn fn) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < rounds; r++) fn(r);
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count() / rounds / BUS_BENCH_LEDS;
+}
+
+int hostBusBenchmark(unsigned rounds, FILE *out) {
+  static const uint8_t gpios[] = {2, 4, 5, 12, 13, 14, 15, 16, 17, 18};
+  unsigned runs = 0;
+  if (rounds == 0) rounds = 1;
+  for (const unsigned n : busCounts) {
+    unsigned start = 0;
+    for (unsigned b = 0; b < n; b++) {
+      const unsigned len = BUS_BENCH_LEDS / n + (b < BUS_BENCH_LEDS % n);
+      uint8_t pins[5] = {gpios[b], 255, 255, 255, 255};
+      busConfigs.emplace_back(TYPE_WS2812_RGB, pins, start, len, COL_ORDER_GRB, false, 0, RGBW_MODE_MANUAL_ONLY);
+      start += len;
+    }
+    strip.finalizeInit();
+    if (BusManager::getNumBusses() != n) continue;
+
+    uint32_t run[64], sink = 0;
+    for (unsigned i = 0; i < 64; i++) run[i] = i * 0x010203;
+    const double scanSet  = nsPerPixel(rounds, [](unsigned r) { for (unsigned i = 0; i < BUS_BENCH_LEDS; i++) scanSetPixelColor(i, i + r); });
+    const double routeSet = nsPerPixel(rounds, [](unsigned r) { for (unsigned i = 0; i < BUS_BENCH_LEDS; i++) BusManager::setPixelColor(i, i + r); });
+    const double routeRun = nsPerPixel(rounds, [&](unsigned r) {
+      for (unsigned i = 0; i < BUS_BENCH_LEDS; i += 64) BusManager::setPixels(i, run, min(64U, BUS_BENCH_LEDS - i));
+    });
+    const double scanGet  = nsPerPixel(rounds, [&](unsigned r) { for (unsigned i = 0; i < BUS_BENCH_LEDS; i++) sink += scanGetPixelColor(i); });
+    const double routeGet = nsPerPixel(rounds, [&](unsigned r) { for (unsigned i = 0; i < BUS_BENCH_LEDS; i++) sink += BusManager::getPixelColor(i); });
+
+    fprintf(out, "{\"buses\":%u,\"leds\":%u,\"rounds\":%u,\"ns_per_px\":{\"scan_set\":%.2f,\"route_set\":%.2f,\"route_run\":%.2f,"
+                 "\"scan_get\":%.2f,\"route_get\":%.2f},\"sink\":%u}\n",
+      n, BUS_BENCH_LEDS, rounds, scanSet, routeSet, routeRun, scanGet, routeGet, (unsigned)sink & 1);
+    runs++;
+  }
+  return runs;
+}
@@ -0,0 +1,337 @@
+/*
+ * Host (native) implementations of the Arduino core, ESP32 HAL and FreeRTOS functions
+ * declared by the shim headers in this library.
+ */
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <ctype.h>
+#include <malloc.h>
+#include <sys/stat.h>
+
+#include "Arduino.h"
+#include "LittleFS.h"
+#include "ESPmDNS.h"
+#include "WiFi.h"
+#include "ETH.h"
+#include "Update.h"
+#include "soc/ledc_struct.h"
+
+//
+// time
+//
+static const auto _bootTime = std::chrono::steady_clock::now();
+static bool     _virtualClock = false;
+static uint64_t _virtualMicros = 0;
+
+static uint64_t hostMicros64() {
+  if (_virtualClock) return _virtualMicros;
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _bootTime).count();
+}
+
+// virtual time starts at 0 (not at the wall time since start) so that runs are reproducible
+void hostUseVirtualClock(bool enable) {
+  _virtualClock = enable;
+}
+
+void hostAdvanceClock(uint32_t us) { _virtualMicros += us; }
+
+unsigned long millis() { return hostMicros64() / 1000ULL; }
+unsigned long micros() { return hostMicros64(); }
+uint64_t esp_rtc_get_time_us() { return hostMicros64(); }
+int64_t  esp_timer_get_time()  { return hostMicros64(); }
+
+void delay(uint32_t ms) {
+  if (_virtualClock) hostAdvanceClock(ms * 1000U);
+  else std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+  if (_virtualClock) hostAdvanceClock(us);
+  else std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {}
+
+//
+// heap (single heap, capabilities are ignored)
+//
+static host_heap_stats_t _heap = {0, 0, 0};
+
+static void *heapTrack(void *ptr) {
+  if (ptr) {
+    _heap.used += malloc_usable_size(ptr);
+    if (_heap.used > _heap.peak) _heap.peak = _heap.used;
+    _heap.allocs++;
+  }
+  return ptr;
+}
+
+void *heap_caps_malloc(size_t size, uint32_t caps)               { return heapTrack(malloc(size)); }
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps)     { return heapTrack(calloc(n, size)); }
+void *heap_caps_malloc_prefer(size_t size, size_t num, ...)      { return heapTrack(malloc(size)); }
+void *heap_caps_realloc_prefer(void *ptr, size_t size, size_t num, ...) { return heap_caps_realloc(ptr, size, 0); }
+
+void *heap_caps_realloc(void *ptr, size_t size, uint32_t caps) {
+  size_t old = ptr ? malloc_usable_size(ptr) : 0;
+  void *buf = realloc(ptr, size);
+  if (!buf) return nullptr;  // old buffer is still valid
+  _heap.used -= old;
+  return heapTrack(buf);
+}
+
+void heap_caps_free(void *ptr) {
+  if (ptr) _heap.used -= malloc_usable_size(ptr);
+  free(ptr);
+}
+
+size_t heap_caps_get_free_size(uint32_t caps)                    { return 256*1024; }
+size_t heap_caps_get_largest_free_block(uint32_t caps)           { return 128*1024; }
+
+host_heap_stats_t hostHeapStats() { return _heap; }
+void hostResetHeapPeak() { _heap.peak = _heap.used; }
+
+//
+// misc ESP32 HAL
+//
+static std::mt19937 _hwRng(0x57454C44); // fixed seed, the host build has no entropy source to emulate
+
+uint32_t esp_random() { return _hwRng(); }
+
+EspClass ESP;
+void EspClass::restart() { fflush(stdout); exit(0); }
+
+ledc_dev_t LEDC;
+
+//
+// Arduino core
+//
+size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size) {
+    size_t n = len >= size ? size - 1 : len;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+
+size_t strlcat(char *dst, const char *src, size_t size) {
+  size_t dlen = strnlen(dst, size);
+  if (dlen == size) return size + strlen(src);
+  return dlen + strlcpy(dst + dlen, src, size - dlen);
+}
+
+static char *ulltoa(unsigned long long v, char *str, int base, bool negative) {
+  char tmp[66];
+  int i = 0;
+  if (base < 2 || base > 36) base = 10;
+  do { unsigned d = v % base; tmp[i++] = d < 10 ? '0' + d : 'a' + d - 10; v /= base; } while (v);
+  char *p = str;
+  if (negative) *p++ = '-';
+  while (i) *p++ = tmp[--i];
+  *p = '\0';
+  return str;
+}
+
+char *itoa(int value, char *str, int base)       { return ltoa(value, str, base); }
+char *utoa(unsigned value, char *str, int base)  { return ulltoa(value, str, base, false); }
+char *ltoa(long value, char *str, int base) {
+  if (base == 10 && value < 0) return ulltoa(-(unsigned long long)value, str, base, true);
+  return ulltoa((unsigned long)value, str, base, false);
+}
+
+char *dtostrf(double number, signed char width, unsigned char prec, char *s) {
+  sprintf(s, "%*.*f", width, prec, number);
+  return s;
+}
+
+long random(long howbig) { return howbig ? (long)(esp_random() % (unsigned long)howbig) : 0; }
+long random(long howsmall, long howbig) { return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall); }
+void randomSeed(unsigned long seed) { if (seed) _hwRng.seed(seed); }
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  if (in_max == in_min) return out_min;
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {}
+void digitalWrite(uint8_t pin, uint8_t val) {}
+int  digitalRead(uint8_t pin) { return LOW; }
+uint16_t analogRead(uint8_t pin) { return 0; }
+
+//
+// String / Print / Serial
+//
+bool String::equalsIgnoreCase(const String &o) const {
+  return _s.length() == o._s.length() && strcasecmp(_s.c_str(), o._s.c_str()) == 0;
+}
+
+void String::replace(const String &f, const String &r) {
+  if (f._s.empty()) return;
+  size_t pos = 0;
+  while ((pos = _s.find(f._s, pos)) != std::string::npos) {
+    _s.replace(pos, f._s.length(), r._s);
+    pos += r._s.length();
+  }
+}
+
+void String::toLowerCase() { for (auto &c : _s) c = tolower((unsigned char)c); }
+void String::toUpperCase() { for (auto &c : _s) c = toupper((unsigned char)c); }
+
+void String::trim() {
+  size_t b = _s.find_first_not_of(" \t\r\n");
+  if (b == std::string::npos) { _s.clear(); return; }
+  size_t e = _s.find_last_not_of(" \t\r\n");
+  _s = _s.substr(b, e - b + 1);
+}
+
+void String::fromNumber(long long v, unsigned char base) {
+  char buf[68];
+  if (v < 0 && base == 10) ulltoa(-(unsigned long long)v, buf, base, true);
+  else ulltoa((unsigned long long)v, buf, base, false);
+  _s = buf;
+}
+
+void String::fromFloat(double v, unsigned char decimals) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+  _s = buf;
+}
+
+size_t Print::printf(const char *format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (len < 0) return 0;
+  if (len < (int)sizeof(buf)) return write((const uint8_t*)buf, len);
+  std::string big(len + 1, '\0');
+  va_start(args, format);
+  vsnprintf(&big[0], big.size(), format, args);
+  va_end(args);
+  return write((const uint8_t*)big.data(), len);
+}
+
+size_t Print::print(long v, int base) {
+  char buf[68];
+  if (v < 0 && base == 10) ulltoa(-(unsigned long long)v, buf, base, true);
+  else ulltoa((unsigned long)v, buf, base, false);
+  return write(buf);
+}
+
+size_t Print::print(unsigned long v, int base) {
+  char buf[68];
+  return write(ulltoa(v, buf, base, false));
+}
+
+size_t Print::print(double v, int digits) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", digits, v);
+  return write(buf);
+}
+
+HardwareSerial Serial;
+size_t HardwareSerial::write(uint8_t c) { return fwrite(&c, 1, 1, stdout); }
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) { return fwrite(buffer, 1, size, stdout); }
+
+//
+// FreeRTOS
+//
+// one type for mutexes and binary semaphores so xSemaphoreTake()/xSemaphoreGive() work on both
+struct HostSemaphore {
+  bool                       binary;
+  std::recursive_timed_mutex mutex;  // mutex
+  std::mutex                 lock;   // binary semaphore
+  std::condition_variable    cv;
+  bool                       given = false;
+  explicit HostSemaphore(bool b) : binary(b) {}
+};
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { return new HostSemaphore(false); }
+SemaphoreHandle_t xSemaphoreCreateMutex()          { return new HostSemaphore(false); }
+SemaphoreHandle_t xSemaphoreCreateBinary()         { return new HostSemaphore(true); }
+void vSemaphoreDelete(SemaphoreHandle_t sem)        { delete static_cast<HostSemaphore*>(sem); }
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t sem, TickType_t ticks) {
+  auto s = static_cast<HostSemaphore*>(sem);
+  if (!s) return pdFALSE;
+  if (s->binary) {
+    std::unique_lock<std::mutex> l(s->lock);
+    auto given = [s] { return s->given; };
+    if (ticks == portMAX_DELAY) s->cv.wait(l, given);
+    else if (!s->cv.wait_for(l, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS), given)) return pdFALSE;
+    s->given = false;
+    return pdTRUE;
+  }
+  if (ticks == portMAX_DELAY) { s->mutex.lock(); return pdTRUE; }
+  return s->mutex.try_lock_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS)) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t sem) {
+  auto s = static_cast<HostSemaphore*>(sem);
+  if (!s) return pdFALSE;
+  if (s->binary) {
+    {
+      std::lock_guard<std::mutex> l(s->lock);
+      if (s->given) return pdFALSE; // already given
+      s->given = true;
+    }
+    s->cv.notify_one();
+    return pdTRUE;
+  }
+  s->mutex.unlock();
+  return pdTRUE;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *param, UBaseType_t prio, TaskHandle_t *handle, BaseType_t core) {
+  std::thread *t = new std::thread(fn, param);
+  t->detach();
+  if (handle) *handle = t;
+  return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {} // tasks end by returning from their function on the host
+void vTaskDelay(TickType_t ticks) { delay(ticks * portTICK_PERIOD_MS); }
+TickType_t xTaskGetTickCount() { return millis() / portTICK_PERIOD_MS; }
+
+BaseType_t xPortGetCoreID() { return 0; }
+
+//
+// LittleFS (mapped onto a host directory)
+//
+static std::string _fsRoot = ".";
+
+void hostSetFsRoot(const char *path) { _fsRoot = path ? path : "."; }
+
+static std::string hostPath(const char *path) { return _fsRoot + (path && path[0] == '/' ? "" : "/") + (path ? path : ""); }
+
+namespace fs {
+File FS::open(const char *path, const char *mode) {
+  std::string p = hostPath(path);
+  std::string m(mode ? mode : "r");
+  if (m.find('b') == std::string::npos) m += 'b';
+  FILE *f = fopen(p.c_str(), m.c_str());
+  return File(f, path);
+}
+
+bool FS::exists(const char *path) {
+  struct stat st;
+  return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char *path) { return ::remove(hostPath(path).c_str()) == 0; }
+bool FS::rename(const char *from, const char *to) { return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0; }
+} // namespace fs
+
+fs::FS LittleFS;
+
+//
+// network/OTA singletons (all inert)
+//
+WiFiClass WiFi;
+ETHClass ETH;
+MDNSResponder MDNS;
+UpdateClass Update;
@@ -0,0 +1,72 @@
+/*
+ * Host (native) build: strip setup and frame loop shared by the driver and the benchmark.
+ */
+#include <chrono>
+#include "wled.h"
+#include "host_engine.h"
+
+// splits the strip into buses of at most MAX_LEDS_PER_BUS LEDs (like a multi-output controller would)
+static void addBuses(unsigned leds, bool rgbw) {
+  static const uint8_t gpios[] = {2, 4, 5, 12, 13, 14, 15, 16, 17, 18, 19, 21, 22, 23, 25, 26};
+  unsigned start = 0;
+  for (unsigned b = 0; start < leds && b < WLED_MAX_DIGITAL_CHANNELS; b++) {
+    unsigned len = min(leds - start, (unsigned)MAX_LEDS_PER_BUS);
+    uint8_t pins[5] = {gpios[b], 255, 255, 255, 255};
+    busConfigs.emplace_back(rgbw ? TYPE_SK6812_RGBW : TYPE_WS2812_RGB, pins, start, len, COL_ORDER_GRB, false, 0, rgbw ? RGBW_MODE_AUTO_ACCURATE : RGBW_MODE_MANUAL_ONLY);
+    start += len;
+  }
+}
+
+// FNV-1a over the colors stored in the buses
+static uint32_t busChecksum(uint32_t hash) {
+  for (unsigned i = 0; i < strip.getLengthTotal(); i++) {
+    uint32_t c = BusManager::getPixelColor(i);
+    for (unsigned b = 0; b < 4; b++) {
+      hash ^= (c >> (8*b)) & 0xFF;
+      hash *= 16777619UL;
+    }
+  }
+  return hash;
+}
+
+void hostSetupStrip(unsigned leds, unsigned width, unsigned height, bool rgbw, unsigned fps) {
+  #ifndef WLED_DISABLE_2D
+  strip.panel.clear();
+  strip.isMatrix = false;
+  if (width && height) {
+    WS2812FX::Panel p;
+    p.width  = width;
+    p.height = height;
+    strip.panel.push_back(p);
+    strip.isMatrix = true;
+    leds = width * height;
+  }
+  #endif
+  if (leds > MAX_LEDS) leds = MAX_LEDS;
+
+  NeoGammaWLEDMethod::calcGammaTable(gammaCorrectVal); // normally done while loading cfg.json
+  strip.setTargetFps(fps);
+  strip.setTransition(0);
+  addBuses(leds, rgbw);
+  bri = 255;                // buses pick up the global brightness when created
+  strip.finalizeInit();
+  strip.makeAutoSegments(true);
+  strip.setBrightness(bri, true);
+}
+
+host_run_result_t hostRunFrames(unsigned frames, bool checksum) {
+  const unsigned frameUs = strip.getFrameTimeUs(); // every iteration hits the scheduler's deadline
+  host_run_result_t res = {0, 0, 2166136261UL};
+  for (unsigned f = 0; f < frames; f++) {
+    hostAdvanceClock(frameUs);
+    uint32_t lastShow = strip.getLastShow();
+    auto t0 = std::chrono::steady_clock::now();
+    strip.service();
+    res.renderNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+    if (strip.getLastShow() != lastShow) {
+      res.shown++;
+      if (checksum) res.checksum = busChecksum(res.checksum);
+    }
+  }
+  return res;
+}
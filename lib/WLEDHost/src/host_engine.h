@@ -0,0 +1,27 @@
+#pragma once
+/*
+ * Host (native) build: helpers shared by the headless driver (host_main.cpp) and the
+ * effect benchmark (host_bench.cpp) to configure the strip and render frames on the virtual clock.
+ */
+#ifndef WLED_HOST_ENGINE_H
+#define WLED_HOST_ENGINE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct {
+  unsigned shown;     // number of frames that were actually pushed to the buses
+  uint64_t renderNs;  // wall time spent in WS2812FX::service()
+  uint32_t checksum;  // FNV-1a over the bus contents of all shown frames
+} host_run_result_t;
+
+// (re)creates buses and segments: 1D strip of leds LEDs if width or height is 0, matrix otherwise
+void hostSetupStrip(unsigned leds, unsigned width, unsigned height, bool rgbw, unsigned fps);
+// advances the virtual clock by one frame time per frame and calls strip.service()
+host_run_result_t hostRunFrames(unsigned frames, bool checksum = true);
+// runs every effect on a set of 1D, 2D and 1D-on-2D shapes and writes one JSON object per line to out
+int hostBenchmark(unsigned frames, bool rgbw, FILE *out);
+// times BusManager pixel routing (linear bus scan vs routing table) with 1, 4, 8 and 10 buses, one JSON object per line
+int hostBusBenchmark(unsigned rounds, FILE *out);
+
+#endif
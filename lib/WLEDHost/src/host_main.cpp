@@ -0,0 +1,94 @@
+/*
+ * Headless driver for the host (native) build of the WLED render engine.
+ *
+ * Sets up in-memory LED buses (see HostPolyBus.h), selects an effect and runs WS2812FX::service()
+ * on a virtual clock so every iteration renders exactly one frame. Reports render time per frame
+ * and a checksum of the bus output (identical output => identical checksum).
+ *
+ * With -b all effects are benchmarked instead, with -B bus pixel routing (see host_bench.cpp).
+ *
+ * usage: wled_host [-l leds | -m WxH] [-e effect] [-p palette] [-s speed] [-i intensity] [-f frames] [-F fps] [-w] [-d fsroot] [-r seed] [-b] [-B]
+ */
+#include <chrono>
+#include <getopt.h>
+#include "wled.h"
+#include "host_engine.h"
+
+static void usage(const char *name) {
+  fprintf(stderr, "usage: %s [-l leds | -m WxH] [-e effect] [-p palette] [-s speed] [-i intensity] [-f frames] [-F fps] [-w] [-d fsroot] [-r seed] [-b] [-B]\n", name);
+  fprintf(stderr, "  -l  number of LEDs (1D), default 300\n");
+  fprintf(stderr, "  -m  2D matrix size, e.g. 32x32\n");
+  fprintf(stderr, "  -e  effect ID, default 0 (Solid)\n");
+  fprintf(stderr, "  -p  palette ID, default 0\n");
+  fprintf(stderr, "  -s  effect speed, default 128\n");
+  fprintf(stderr, "  -i  effect intensity, default 128\n");
+  fprintf(stderr, "  -f  number of frames to render, default 1000\n");
+  fprintf(stderr, "  -F  target FPS (virtual time per frame), default 42\n");
+  fprintf(stderr, "  -w  use RGBW buses\n");
+  fprintf(stderr, "  -d  directory used as LittleFS root (ledmaps, palettes), default .\n");
+  fprintf(stderr, "  -r  seed for effect randomness (WLED_ENABLE_DETERMINISTIC_RNG), default 0\n");
+  fprintf(stderr, "  -b  benchmark all effects on 1D, 2D and 1D-on-2D shapes, JSON lines on stdout\n");
+  fprintf(stderr, "  -B  benchmark bus pixel routing with 1, 4, 8 and 10 buses (-f rounds), JSON lines on stdout\n");
+}
+
+int main(int argc, char **argv) {
+  unsigned leds = 300, width = 0, height = 0;
+  unsigned effect = FX_MODE_STATIC, pal = 0, speed = DEFAULT_SPEED, intensity = DEFAULT_INTENSITY;
+  unsigned frames = 1000, fps = WLED_FPS;
+  uint32_t seed = 0;
+  bool rgbw = false, bench = false, busBench = false;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "l:m:e:p:s:i:f:F:wd:r:bBh")) != -1) {
+    switch (opt) {
+      case 'l': leds = atoi(optarg); break;
+      case 'm': if (sscanf(optarg, "%ux%u", &width, &height) != 2) { usage(argv[0]); return 1; } break;
+      case 'e': effect = atoi(optarg); break;
+      case 'p': pal = atoi(optarg); break;
+      case 's': speed = atoi(optarg); break;
+      case 'i': intensity = atoi(optarg); break;
+      case 'f': frames = atoi(optarg); break;
+      case 'F': fps = atoi(optarg); break;
+      case 'w': rgbw = true; break;
+      case 'd': hostSetFsRoot(optarg); break;
+      case 'r': seed = strtoul(optarg, nullptr, 0); break;
+      case 'b': bench = true; break;
+      case 'B': busBench = true; break;
+      default : usage(argv[0]); return opt == 'h' ? 0 : 1;
+    }
+  }
+
+  hostUseVirtualClock(true);
+  hostAdvanceClock(1000000); // start at 1s uptime, some effects do not like 0
+  #ifdef WLED_ENABLE_DETERMINISTIC_RNG
+  strip.setRandomSeed(seed);
+  #endif
+
+  if (bench) {
+    unsigned runs = hostBenchmark(frames, rgbw, stdout);
+    fprintf(stderr, "%u benchmark runs of %u frames\n", runs, frames);
+    return errorFlag != ERR_NONE;
+  }
+
+  if (busBench) {
+    unsigned runs = hostBusBenchmark(frames, stdout);
+    fprintf(stderr, "%u bus benchmark runs of %u rounds\n", runs, frames);
+    return errorFlag != ERR_NONE;
+  }
+
+  hostSetupStrip(leds, width, height, rgbw, fps);
+
+  Segment &seg = strip.getMainSegment();
+  seg.setMode(effect);
+  seg.setPalette(pal);
+  seg.speed = speed;
+  seg.intensity = intensity;
+
+  host_run_result_t res = hostRunFrames(frames);
+
+  const char *name = strip.getModeData(effect);
+  printf("effect %u (%.*s) pal %u %ux%u %u LEDs %u buses %u frames %u shown %.3f ms/frame %.1f ns/pixel checksum %08x\n",
+    effect, (int)strcspn(name, "@"), name, pal, Segment::maxWidth, Segment::maxHeight, strip.getLengthTotal(), (unsigned)BusManager::getNumBusses(),
+    frames, res.shown, frames ? res.renderNs / 1e6 / frames : 0.0, frames ? (double)res.renderNs / frames / strip.getLengthTotal() : 0.0, (unsigned)res.checksum);
+  return errorFlag != ERR_NONE;
+}
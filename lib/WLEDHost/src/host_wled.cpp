@@ -0,0 +1,43 @@
+/*
+ * Host (native) build: instantiates the WLED globals and provides the few functions
+ * the render engine needs from translation units that are not part of the host build
+ * (led.cpp, file.cpp, udp.cpp, e131.cpp, wled_server.cpp).
+ */
+#define WLED_DEFINE_GLOBAL_VARS
+#include "wled.h"
+
+// led.cpp
+byte scaledBri(byte in)
+{
+  unsigned val = ((unsigned)in*briMultiplier)/100;
+  if (val > 255) val = 255;
+  return (byte)val;
+}
+
+uint32_t get_millisecond_timer() {
+  return strip.now;
+}
+
+// file.cpp (LittleFS is mapped onto a host directory, see hostSetFsRoot())
+bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, const JsonDocument* filter)
+{
+  File f = WLED_FS.open(file, "r");
+  if (!f) return false;
+  if (key != nullptr && !f.find(key)) { //key does not exist in file
+    f.close();
+    dest->clear();
+    return false;
+  }
+  if (filter) deserializeJson(*dest, f, DeserializationOption::Filter(*filter));
+  else        deserializeJson(*dest, f);
+  f.close();
+  return true;
+}
+
+// network side effects are not available on the host
+uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri, bool isRGBW) { return 1; }
+void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol) {}
+void createEditHandler(bool enable) {}
+
+ESPAsyncE131::ESPAsyncE131(e131_packet_callback_function callback) : _callback(callback) {}
+bool ESPAsyncE131::begin(bool multicast, uint16_t port, uint16_t universe, uint8_t n) { return false; }
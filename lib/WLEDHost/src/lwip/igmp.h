@@ -0,0 +1,2 @@
+#pragma once
+// intentionally empty: not needed by the host build of the render engine
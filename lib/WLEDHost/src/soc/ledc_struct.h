@@ -0,0 +1,14 @@
+#pragma once
+/*
+ * LEDC register block stub for the host build (writes land in plain memory).
+ */
+#include <stdint.h>
+typedef struct {
+  struct {
+    struct {
+      struct { uint32_t hpoint; } hpoint;
+      struct { uint32_t duty; } duty;
+    } channel[8];
+  } channel_group[2];
+} ledc_dev_t;
+extern ledc_dev_t LEDC;
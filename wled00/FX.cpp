@@ -135,8 +135,12 @@ uint16_t mode_copy_segment(void) {
     SEGMENT.fadeToBlackBy(5); // fade out
     return FRAMETIME;
   }
-  Segment sourcesegment = strip.getSegment(sourceid);
+  const Segment &sourcesegment = strip.getSegment(sourceid); // read in place, copying the segment would allocate a pixel buffer each frame
   if (sourcesegment.isActive()) {
+    // source dimensions are calculated locally, the source segment's draw context must not be touched (it may be rendering concurrently)
+    const unsigned srcW = sourcesegment.virtualWidth();
+    const unsigned srcH = sourcesegment.virtualHeight();
+    const unsigned srcL = sourcesegment.virtualLength();
     uint32_t sourcecolor;
     uint32_t destcolor;
     if(sourcesegment.is2D()) { // 2D source, note: 2D to 1D just copies the first row (or first column if 'Switch axis' is checked in FX)
@@ -149,11 +153,9 @@ uint16_t mode_copy_segment(void) {
             sourcecolor = strip.getPixelColorXY(sx + sourcesegment.start, sy + sourcesegment.startY); // read from global buffer (reads the last rendered frame)
           }
           else {
-            sourcesegment.setDrawDimensions(); // set to source segment dimensions
-            sourcecolor = sourcesegment.getPixelColorXY(sx, sy); // read from segment buffer
+            sourcecolor = (sx < srcW && sy < srcH) ? sourcesegment.getRawPixelColor(sx + sy * srcW) : BLACK; // read from segment buffer
           }
           destcolor = adjust_color(sourcecolor, SEGMENT.intensity, SEGMENT.custom1, SEGMENT.custom2);
-          SEGMENT.setDrawDimensions(); // reset to current segment dimensions
           SEGMENT.setPixelColorXY(x, y, destcolor);
         }
       }
@@ -163,11 +165,9 @@ uint16_t mode_copy_segment(void) {
           sourcecolor = strip.getPixelColor(i + sourcesegment.start); // read from global buffer (reads the last rendered frame)
         }
         else {
-          sourcesegment.setDrawDimensions(); // set to source segment dimensions
-          sourcecolor = sourcesegment.getPixelColor(i);
+          sourcecolor = i < srcL ? sourcesegment.getRawPixelColor(i) : BLACK;
         }
         destcolor = adjust_color(sourcecolor, SEGMENT.intensity, SEGMENT.custom1, SEGMENT.custom2);
-        SEGMENT.setDrawDimensions(); // reset to current segment dimensions
         SEGMENT.setPixelColor(i, destcolor);
       }
     }
@@ -2160,7 +2160,7 @@ uint16_t mode_fire_2012() {
       const uint8_t ignition = MAX(3,SEGLEN/10);  // ignition area: 10% of segment length or minimum 3 pixels
 
       // Step 1.  Cool down every cell a little
-      for (unsigned i = 0; i < SEGLEN; i++) {
+      for (unsigned i = 0; i < SEGMENT.vLength(); i++) {
         uint8_t cool = (it != SEGENV.step) ? hw_random8((((20 + SEGMENT.speed/3) * 16) / SEGLEN)+2) : hw_random8(4);
         uint8_t minTemp = (i<ignition) ? (ignition-i)/4 + 16 : 0;  // should not become black in ignition area
         uint8_t temp = qsub8(heat[i], cool);
@@ -18,6 +18,9 @@
 
 #include <vector>
 #include "wled.h"
+#ifdef WLED_ENABLE_PARALLEL_RENDER
+#include <atomic>
+#endif
 
 #ifdef WLED_DEBUG
   // enable additional debug output
@@ -87,6 +90,7 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #define FPS_MULTIPLIER 1 // dev option: multiplier to get sub-frame FPS without floats
 #endif
 #define FPS_CALC_SHIFT 7 // bit shift for fixed point math
+#define CCT_PER_PIXEL  256 // composeFrame() result: CCT of each pixel is in _pixelCCT
 
 // heap memory limit for effects data, pixel buffers try to reserve it if PSRAM is available
 #ifdef ESP8266
@@ -110,15 +114,27 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #define FAIR_DATA_PER_SEG (MAX_SEGMENT_DATA / MAX_NUM_SEGMENTS)
 
 #define MIN_SHOW_DELAY   (_frametime < 16 ? 8 : 15)
+#define MAX_IDLE_SHOW_DELAY 1000 /* unchanged frame is still sent to LEDs this often (ms), recovers from data glitches */
+
+// WLED_ENABLE_PIPELINED_OUTPUT: frame N is sent to LEDs by a task on the other core while effects render frame N+1
+// (needs a dual core ESP32, costs a second frame buffer and adds one frame of latency)
+#if defined(WLED_ENABLE_PIPELINED_OUTPUT) && (!defined(ARDUINO_ARCH_ESP32) || defined(CONFIG_FREERTOS_UNICORE) || defined(CONFIG_IDF_TARGET_ESP32C3) || defined(CONFIG_IDF_TARGET_ESP32S2))
+  #undef WLED_ENABLE_PIPELINED_OUTPUT
+#endif
+
+// per segment lookup table of the interpolated palette (1kB for each segment whose effect uses palettes), see Segment::color_from_palette()
+#if !defined(WLED_DISABLE_PALETTE_LUT) && (defined(ESP8266) || defined(WLED_SAVE_RAM))
+  #define WLED_DISABLE_PALETTE_LUT
+#endif
 
 #define NUM_COLORS       3 /* number of colors per segment */
 #define SEGMENT          (*strip._currentSegment)
 #define SEGENV           (*strip._currentSegment)
-#define SEGCOLOR(x)      Segment::getCurrentColor(x)
-#define SEGPALETTE       Segment::getCurrentPalette()
-#define SEGLEN           Segment::vLength()
-#define SEG_W            Segment::vWidth()
-#define SEG_H            Segment::vHeight()
+#define SEGCOLOR(x)      SEGMENT.getCurrentColor(x)
+#define SEGPALETTE       SEGMENT.getCurrentPalette()
+#define SEGLEN           SEGMENT.vLength()
+#define SEG_W            SEGMENT.vWidth()
+#define SEG_H            SEGMENT.vHeight()
 #define SPEED_FORMULA_L  (5U + (50U*(255U - SEGMENT.speed))/SEGLEN)
 
 // some common colors
@@ -417,9 +433,95 @@ typedef enum mapping1D2D {
   M12_sPinwheel = 4
 } mapping1D2D_t;
 
+// render pipeline timing statistics (in us) over a rolling window of TIMING_WINDOW samples, see WS2812FX::service() & show()
+// p99 (nearest rank: 198th of 200 samples) is the 3rd largest sample so only the three largest samples need to be tracked (no sample buffer)
+#define TIMING_WINDOW 200
+class TimingStats {
+  public:
+    uint16_t min, avg, max, p99;  // results of the last complete window (all 0 until first window completes)
+
+    TimingStats() : min(0), avg(0), max(0), p99(0) { restart(); }
+
+    inline void add(unsigned long us) {
+      uint16_t t = us > UINT16_MAX ? UINT16_MAX : us;
+      _sum += t;
+      if (t < _min) _min = t;
+      if (t > _top[0])      { _top[2] = _top[1]; _top[1] = _top[0]; _top[0] = t; }
+      else if (t > _top[1]) { _top[2] = _top[1]; _top[1] = t; }
+      else if (t > _top[2]) _top[2] = t;
+      if (++_count >= TIMING_WINDOW) {
+        min = _min; avg = _sum / _count; max = _top[0]; p99 = _top[2];
+        restart();
+      }
+    }
+
+  private:
+    uint32_t _sum;
+    uint16_t _count;
+    uint16_t _min;
+    uint16_t _top[3];
+    inline void restart() { _sum = 0; _count = 0; _min = UINT16_MAX; _top[0] = _top[1] = _top[2] = 0; }
+};
+
+// per segment timing (indexed by segment ID)
+typedef struct {
+  TimingStats fx;     // effect function
+  TimingStats old;    // old effect function during transition
+  TimingStats blend;  // blending into frame buffer
+} segment_timing_t;
+
+// frame scheduler statistics, see WS2812FX::service(); results are of the last complete window of SCHED_WINDOW_MS
+// jitter is the delay of a frame's start behind its deadline, histogram bucket b holds [2^b, 2^(b+1)) us (bucket 0 also holds 0)
+#define SCHED_WINDOW_MS 2000
+#define SCHED_BUCKETS   14      // last bucket holds everything above 8 ms
+class FrameStats {
+  public:
+    uint32_t fps100;                  // achieved frame rate in 1/100 FPS (16 bits would wrap above 655 FPS)
+    uint16_t frames;                  // rendered frames
+    uint16_t dropped;                 // deadlines skipped because service() was late by more than a frame
+    uint16_t jitterAvg, jitterMax;    // in us
+    uint16_t hist[SCHED_BUCKETS];     // jitter histogram
+
+    FrameStats() : fps100(0), frames(0), dropped(0), jitterAvg(0), jitterMax(0), hist() { restart(0); }
+
+    // records jitter of a frame started on its deadline and the number of deadlines skipped before it
+    inline void deadline(unsigned long lateUs, unsigned missed) {
+      uint16_t t = lateUs > UINT16_MAX ? UINT16_MAX : lateUs;
+      unsigned b = t ? 31 - __builtin_clz(t) : 0;
+      if (b >= SCHED_BUCKETS) b = SCHED_BUCKETS - 1;
+      if (_hist[b] < UINT16_MAX) _hist[b]++;
+      _jitterSum += t;
+      if (t > _jitterMax) _jitterMax = t;
+      _deadlines++;
+      _dropped += missed;
+    }
+
+    // counts a rendered frame (on deadline or triggered), closes the window when due
+    inline void frame(unsigned long nowUs) {
+      _frames++;
+      unsigned long elapsed = nowUs - _windowStart;
+      if (elapsed < SCHED_WINDOW_MS * 1000UL) return;
+      fps100    = (uint64_t)_frames * 100000000ULL / elapsed;
+      frames    = _frames;
+      dropped   = _dropped;
+      jitterAvg = _deadlines ? _jitterSum / _deadlines : 0;
+      jitterMax = _jitterMax;
+      memcpy(hist, _hist, sizeof(hist));
+      restart(nowUs);
+    }
+
+  private:
+    uint32_t _jitterSum;
+    uint16_t _jitterMax;
+    uint16_t _frames, _deadlines, _dropped;
+    uint16_t _hist[SCHED_BUCKETS];
+    unsigned long _windowStart;
+    inline void restart(unsigned long nowUs) { _jitterSum = 0; _jitterMax = 0; _frames = _deadlines = _dropped = 0; memset(_hist, 0, sizeof(_hist)); _windowStart = nowUs; }
+};
+
 class WS2812FX;
 
-// segment, 76 bytes
+// segment, 92 bytes on ESP32 (160 bytes with WLED_ENABLE_PARALLEL_RENDER as each segment keeps its own draw context)
 class Segment {
   public:
     uint32_t colors[NUM_COLORS];
@@ -477,6 +579,8 @@ class Segment {
     uint32_t *pixels;                 // pixel data
     unsigned _dataLen;
     uint8_t  _default_palette;        // palette number that gets assigned to pal0
+    mutable bool _dirty;              // pixels changed since segment was last blended into frame buffer (see WS2812FX::show())
+    bool     _snapshot;               // transition snapshot: pixels and data are borrowed from the live segment (see detachOldSegment())
     union {
       mutable uint8_t _capabilities;  // determines segment capabilities in terms of what is available: RGB, W, CCT, manual W, etc.
       struct {
@@ -486,18 +590,60 @@ class Segment {
         bool    _manualW  : 1;
       };
     };
+  #ifdef WLED_ENABLE_DETERMINISTIC_RNG
+    uint32_t _rndState;               // hw_random() stream of this segment (swapped in while effect runs)
+    uint16_t _rnd16State;             // FastLED random8()/random16() stream of this segment
+  #endif
+
+  #ifdef WLED_ENABLE_PARALLEL_RENDER
+    // draw context: common pre-calculated values stashed by beginDraw() to speed up effect calculations
+    // each segment has its own so segments can be rendered concurrently
+    mutable uint16_t _vLength;                // 1D dimension used for current effect
+    mutable uint16_t _vWidth, _vHeight;       // 2D dimensions used for current effect
+    bool          _modeBlend;                 // segment is rendered as old effect of a transition
+    uint32_t      _currentColors[NUM_COLORS]; // colors used for current effect (faster access from effect functions)
+    CRGBPalette16 _currentPalette;            // palette used for current effect (includes transition, used in color_from_palette())
+  #endif
+  #ifndef WLED_DISABLE_PALETTE_LUT
+    // _currentPalette interpolated to 256 entries (LINEARBLEND, full brightness), allocated on first color_from_palette()
+    // entries are filled on first use: W byte 0xFF marks a filled entry, table is cleared when _currentPalette changes
+    mutable uint32_t *_paletteLUT;
+    uint32_t          _paletteLUTHash;        // checksum of the palette the table is filled from (draw context may be shared by all segments)
+    mutable bool      _paletteLUTFailed;      // allocation failed in current frame, do not retry until next beginDraw()
+  #endif
 
-    // static variables are use to speed up effect calculations by stashing common pre-calculated values
+  #ifndef WLED_DISABLE_2D
+    // precomputed expansion of 1D virtual pixels onto a 2D segment for arc, corner and pinwheel mapping (see updateMapping1D2D())
+    // a single allocation: header followed by starts[vLength+1], reverse[vLength] and runs[size]
+    // runs of each virtual pixel consist of groups: condition mask, count and count raw pixel indices (x + y*vWidth)
+    struct Mapping1D2D {
+      uint16_t vWidth, vHeight, vLength;      // virtual dimensions the map was built for
+      uint8_t  m12;                           // map1D2D the map was built for
+      uint16_t size;                          // number of entries in runs[]
+      inline uint16_t *starts()  { return reinterpret_cast<uint16_t*>(this + 1); } // index into runs[] for each virtual pixel
+      inline uint16_t *reverse() { return starts() + vLength + 1; }                // raw pixel read by getPixelColor() (0xFFFF if outside)
+      inline uint16_t *runs()    { return reverse() + vLength; }
+      inline size_t   bytes() const { return sizeof(Mapping1D2D) + (2*vLength + 1 + size) * sizeof(uint16_t); }
+      inline bool     isFor(unsigned m, unsigned w, unsigned h) const { return m12 == m && vWidth == w && vHeight == h; }
+    } *_m12map;
+    uint32_t _m12mapFailed;                   // mapping and dimensions no map could be built for (too large or no RAM), not retried
+  #endif
+
+  #ifdef WLED_ENABLE_PARALLEL_RENDER
+    static std::atomic<unsigned> _usedSegmentData; // amount of data used by all segments (effects allocate from several render tasks)
+  #else
     static unsigned      _usedSegmentData;    // amount of data used by all segments
+    // static variables are use to speed up effect calculations by stashing common pre-calculated values (segments are rendered one at a time)
     static unsigned      _vLength;            // 1D dimension used for current effect
     static unsigned      _vWidth, _vHeight;   // 2D dimensions used for current effect
     static uint32_t      _currentColors[NUM_COLORS]; // colors used for current effect (faster access from effect functions)
     static CRGBPalette16 _currentPalette;     // palette used for current effect (includes transition, used in color_from_palette())
+    static bool          _modeBlend;          // mode/effect blending semaphore
+  #endif
     static CRGBPalette16 _randomPalette;      // actual random palette
     static CRGBPalette16 _newRandomPalette;   // target random palette
     static uint16_t      _lastPaletteChange;  // last random palette change time (in seconds)
     static uint16_t      _nextPaletteBlend;   // next due time for random palette morph (in millis())
-    static bool          _modeBlend;          // mode/effect blending semaphore
     // clipping rectangle used for blending
     static uint16_t      _clipStart, _clipStop;
     static uint8_t       _clipStartY, _clipStopY;
@@ -538,12 +684,12 @@ class Segment {
 
     inline static void     addUsedSegmentData(int len)     { Segment::_usedSegmentData += len; }
 
-    inline uint32_t *getPixels() const                              { return pixels; }
-    inline void     setPixelColorRaw(unsigned i, uint32_t c) const  { pixels[i] = c; }
+    inline uint32_t *getPixels() const                              { _dirty = true; return pixels; } // caller may write to buffer
+    inline void     setPixelColorRaw(unsigned i, uint32_t c) const  { if (pixels[i] != c) { pixels[i] = c; _dirty = true; } }
     inline uint32_t getPixelColorRaw(unsigned i) const              { return pixels[i]; };
   #ifndef WLED_DISABLE_2D
-    inline void     setPixelColorXYRaw(unsigned x, unsigned y, uint32_t c) const  { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; pixels[XY(x,y)] = c; }
-    inline uint32_t getPixelColorXYRaw(unsigned x, unsigned y) const              { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; return pixels[XY(x,y)]; };
+    inline void     setPixelColorXYRaw(unsigned x, unsigned y, uint32_t c) const  { setPixelColorRaw(x + y*vWidth(), c); }
+    inline uint32_t getPixelColorXYRaw(unsigned x, unsigned y) const              { return pixels[x + y*vWidth()]; };
   #endif
     void resetIfRequired();         // sets all SEGENV variables to 0 and clears data buffer
     CRGBPalette16 &loadPalette(CRGBPalette16 &tgt, uint8_t pal);
@@ -556,13 +702,42 @@ class Segment {
       if (isInTransition() && progress() == 0xFFFFU) stopTransition();
     }
     inline uint16_t progress() const          { return isInTransition() ? _t->_progress : 0xFFFFU; } // relies on handleTransition()/updateTransitionProgress() to update progression variable
-    inline Segment *getOldSegment() const     { return isInTransition() ? _t->_oldSegment : nullptr; }
+    inline Segment *getOldSegment() const     { return isInTransition() && _t->_oldSegment && _t->_oldSegment->isActive() ? _t->_oldSegment : nullptr; } // old segment without buffers is not rendered
+    void detachOldSegment();                  // old segment stops borrowing buffers (must be called before this segment's pixels or data change)
 
-    inline static void modeBlend(bool blend)  { Segment::_modeBlend = blend; }
+    inline void modeBlend(bool blend)         { _modeBlend = blend; }
     inline static void setClippingRect(int startX, int stopX, int startY = 0, int stopY = 1) { _clipStart = startX; _clipStop = stopX; _clipStartY = startY; _clipStopY = stopY; };
-    inline static bool isPreviousMode()       { return Segment::_modeBlend; }    // needed for determining CCT/opacity during non-BLEND_STYLE_FADE transition
+    inline bool isPreviousMode() const        { return _modeBlend; }    // needed for determining CCT/opacity during non-BLEND_STYLE_FADE transition
 
     static void handleRandomPalette();
+  #ifndef WLED_DISABLE_2D
+    inline void tagAllocations(uint8_t tag) const { tagAllocation(pixels, tag); tagAllocation(data, tag); tagAllocation(name, tag); tagAllocation(_m12map, tag); } // allocation telemetry
+    void updateMapping1D2D();       // (re)builds _m12map if mapping or virtual dimensions changed
+    void freeMapping1D2D();
+    void copyMapping1D2D(const Segment &orig);
+  #else
+    inline void tagAllocations(uint8_t tag) const { tagAllocation(pixels, tag); tagAllocation(data, tag); tagAllocation(name, tag); } // allocation telemetry
+    inline void updateMapping1D2D() {}
+    inline void freeMapping1D2D() {}
+    inline void copyMapping1D2D(const Segment &orig) {}
+  #endif
+
+  #ifndef WLED_DISABLE_PALETTE_LUT
+    uint32_t paletteLookup(uint8_t index) const; // color of _currentPalette at index (LINEARBLEND, full brightness, W is 0)
+    inline void freePaletteLUT()          { p_free(_paletteLUT); _paletteLUT = nullptr; }
+  #else
+    inline void freePaletteLUT()          {}
+  #endif
+
+  #ifdef WLED_ENABLE_DETERMINISTIC_RNG
+    inline void seedRandom(uint32_t seed) { _rndState = seed; _rnd16State = (seed >> 16) ^ seed; }
+    inline void loadRandom() const        { hwRndState = _rndState; rand16seed = _rnd16State; }
+    inline void saveRandom()              { _rndState = hwRndState; _rnd16State = rand16seed; }
+  #else
+    inline void seedRandom(uint32_t seed) {}
+    inline void loadRandom() const        {}
+    inline void saveRandom()              {}
+  #endif
 
   public:
 
@@ -598,22 +773,46 @@ class Segment {
     , data(nullptr)
     , _dataLen(0)
     , _default_palette(6)
+    , _dirty(true)
+    , _snapshot(false)
     , _capabilities(0)
+  #ifdef WLED_ENABLE_PARALLEL_RENDER
+    , _vLength(0)
+    , _vWidth(0)
+    , _vHeight(0)
+    , _modeBlend(false)
+    , _currentColors{DEFAULT_COLOR,BLACK,BLACK}
+    , _currentPalette(CRGBPalette16(CRGB::Black))
+  #endif
+  #ifndef WLED_DISABLE_PALETTE_LUT
+    , _paletteLUT(nullptr)
+    , _paletteLUTHash(0)
+    , _paletteLUTFailed(false)
+  #endif
+  #ifndef WLED_DISABLE_2D
+    , _m12map(nullptr)
+    , _m12mapFailed(0)
+  #endif
     , _t(nullptr)
     {
       DEBUGFX_PRINTF_P(PSTR("-- Creating segment: %p [%d,%d:%d,%d]\n"), this, (int)start, (int)stop, (int)startY, (int)stopY);
       // allocate render buffer (always entire segment), prefer PSRAM if DRAM is running low. Note: impact on FPS with PSRAM buffer is low (<2% with QSPI PSRAM)
-      pixels = static_cast<uint32_t*>(allocate_buffer(length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR));
+      pixels = static_cast<uint32_t*>(allocate_buffer(length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR | BFRALLOC_TAG(ALLOC_TAG_SEGPIXELS)));
       if (!pixels) {
         DEBUGFX_PRINTLN(F("!!! Not enough RAM for pixel buffer !!!"));
         extern byte errorFlag;
         errorFlag = ERR_NORAM_PX;
         stop = 0; // mark segment as inactive/invalid
       }
+    #ifdef WLED_ENABLE_PARALLEL_RENDER
+      setDrawDimensions();
+    #endif
     }
 
     Segment(const Segment &orig); // copy constructor
     Segment(Segment &&orig) noexcept; // move constructor
+    struct snapshot_t {};
+    Segment(const Segment &orig, snapshot_t); // transition snapshot: copies settings, borrows pixels and data of orig
 
     ~Segment() {
       #ifdef WLED_DEBUG
@@ -624,7 +823,10 @@ class Segment {
       DEBUGFX_PRINTLN();
       #endif
       clearName();
+      freePaletteLUT();
+      if (_snapshot) return; // buffers belong to the live segment
       deallocateData();
+      freeMapping1D2D();
       p_free(pixels);
     }
 
@@ -632,7 +834,18 @@ class Segment {
     Segment& operator= (Segment &&orig) noexcept; // move assignment
 
 #ifdef WLED_DEBUG
-    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (name?strlen(name):0) + (_t?sizeof(Transition):0) + (pixels?length()*sizeof(uint32_t):0); }
+    size_t getSize() const {
+      size_t size = sizeof(Segment) + (name?strlen(name):0);
+      if (!_snapshot) size += (data?_dataLen:0) + (pixels?length()*sizeof(uint32_t):0); // borrowed buffers are accounted in live segment
+      if (_t) size += sizeof(Transition) + (_t->_oldSegment ? _t->_oldSegment->getSize() : 0);
+      #ifndef WLED_DISABLE_PALETTE_LUT
+      if (_paletteLUT) size += 256 * sizeof(uint32_t);
+      #endif
+      #ifndef WLED_DISABLE_2D
+      if (_m12map) size += _m12map->bytes();
+      #endif
+      return size;
+    }
 #endif
 
     inline bool     getOption(uint8_t n)   const { return ((options >> n) & 0x01); }
@@ -651,13 +864,13 @@ class Segment {
     inline Segment &clearName()                  { p_free(name); name = nullptr; return *this; }
     inline Segment &setName(const String &name)  { return setName(name.c_str()); }
 
-    inline static unsigned vLength()                       { return Segment::_vLength; }
-    inline static unsigned vWidth()                        { return Segment::_vWidth; }
-    inline static unsigned vHeight()                       { return Segment::_vHeight; }
-    inline static uint32_t getCurrentColor(unsigned i)     { return Segment::_currentColors[i<NUM_COLORS?i:0]; }
-    inline static const CRGBPalette16 &getCurrentPalette() { return Segment::_currentPalette; }
+    inline unsigned vLength() const                        { return _vLength; }
+    inline unsigned vWidth() const                         { return _vWidth; }
+    inline unsigned vHeight() const                        { return _vHeight; }
+    inline uint32_t getCurrentColor(unsigned i) const      { return _currentColors[i<NUM_COLORS?i:0]; }
+    inline const CRGBPalette16 &getCurrentPalette() const  { return _currentPalette; }
 
-    inline void setDrawDimensions() const { Segment::_vWidth = virtualWidth(); Segment::_vHeight = virtualHeight(); Segment::_vLength = virtualLength(); }
+    inline void setDrawDimensions() const { _vWidth = virtualWidth(); _vHeight = virtualHeight(); _vLength = virtualLength(); }
 
     void    beginDraw(uint16_t prog = 0xFFFFU);         // set up parameters for current effect
     void    setGeometry(uint16_t i1, uint16_t i2, uint8_t grp=1, uint8_t spc=0, uint16_t ofs=UINT16_MAX, uint16_t i1Y=0, uint16_t i2Y=1, uint8_t m12=0);
@@ -695,6 +908,7 @@ class Segment {
     inline void setPixelColor(int n, byte r, byte g, byte b, byte w = 0) const { setPixelColor(n, RGBW32(r,g,b,w)); }
     inline void setPixelColor(int n, CRGB c) const                             { setPixelColor(n, RGBW32(c.r,c.g,c.b,0)); }
     void setRawPixelColor(int i, uint32_t col) const                           { if (i >= 0 && i < length()) setPixelColorRaw(i,col); }
+    uint32_t getRawPixelColor(int i) const                                     { return (i >= 0 && i < length()) ? getPixelColorRaw(i) : 0; } // render buffer index (virtual coordinates), no draw context needed
     #ifdef WLED_USE_AA_PIXELS
     void setPixelColor(float i, uint32_t c, bool aa = true) const;
     inline void setPixelColor(float i, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0, bool aa = true) const { setPixelColor(i, RGBW32(r,g,b,w), aa); }
@@ -831,7 +1045,6 @@ class WS2812FX {
 
     WS2812FX() :
       paletteBlend(0),
-      now(millis()),
       timebase(0),
       isMatrix(false),
 #ifdef WLED_AUTOSEGMENTS
@@ -849,20 +1062,43 @@ class WS2812FX {
       _length(DEFAULT_LED_COUNT),
       _transitionDur(750),
       _frametime(FRAMETIME_FIXED),
+      _frameTimeUs(1000000UL / WLED_FPS),
       _cumulativeFps(WLED_FPS << FPS_CALC_SHIFT),
       _targetFps(WLED_FPS),
       _isServicing(false),
       _isOffRefreshRequired(false),
       _hasWhiteChannel(false),
       _triggered(false),
-      _segment_index(0),
+      _pixelCCTDirty(false),
+      _frameValid(false),
+      _idle(false),
       _mainSegment(0),
+      _blendedSegments(0),
       _modeCount(MODE_COUNT),
       _callback(nullptr),
       customMappingTable(nullptr),
       customMappingSize(0),
       _lastShow(0),
-      _lastServiceShow(0)
+      _lastServiceShow(0),
+      _nextFrameUs(0),
+      _idleSince(0),
+      _idleFrames(0)
+#ifdef WLED_ENABLE_PIPELINED_OUTPUT
+      , _outPixels(nullptr)
+      , _outPixelCCT(nullptr)
+      , _outCCT(-1)
+      , _outputTask(nullptr)
+      , _outputStart(nullptr)
+      , _outputDone(nullptr)
+      , _outputPending(false)
+      , _outputBusy(false)
+#endif
+#ifdef WLED_ENABLE_PARALLEL_RENDER
+      , _renderTasks()
+      , _renderCount(0)
+      , _renderNext(0)
+      , _renderNow(0)
+#endif
     {
       _mode.reserve(_modeCount);     // allocate memory to prevent initial fragmentation (does not increase size())
       _modeData.reserve(_modeCount); // allocate memory to prevent initial fragmentation (does not increase size())
@@ -873,6 +1109,10 @@ class WS2812FX {
     ~WS2812FX() {
       p_free(_pixels);
       p_free(_pixelCCT); // just in case
+#ifdef WLED_ENABLE_PIPELINED_OUTPUT
+      p_free(_outPixels);
+      p_free(_outPixelCCT);
+#endif
       d_free(customMappingTable);
       _mode.clear();
       _modeData.clear();
@@ -896,13 +1136,14 @@ class WS2812FX {
       resetSegments(),                            // marks all segments for reset
       makeAutoSegments(bool forceReset = false),  // will create segments based on configured outputs
       fixInvalidSegments(),                       // fixes incorrect segment configuration
-      blendSegment(const Segment &topSegment) const,    // blends topSegment into pixels
+      blendSegment(const Segment &topSegment, uint8_t *pixelCCT) const, // blends topSegment into pixels (and its CCT into pixelCCT if not nullptr)
       show(),                                     // initiates LED output
       setTargetFps(unsigned fps),
       setupEffectData(),                          // add default effects to the list; defined in FX.cpp
       waitForIt();                                // wait until frame is over (service() has finished or time for 1 frame has passed)
 
     void setRealtimePixelColor(unsigned i, uint32_t c);
+    void setRealtimePixels(unsigned i, const uint8_t *data, unsigned count, unsigned channels); // bulk RGB/RGBW ingest
     inline void setPixelColor(unsigned n, uint32_t c) const   { if (n < getLengthTotal()) _pixels[n] = c; }  // paints absolute strip pixel with index n and color c
     inline void resetTimebase()                               { timebase = 0UL - millis(); }
     inline void setPixelColor(unsigned n, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0) const
@@ -916,6 +1157,10 @@ class WS2812FX {
                                                               { if (_segments.size() < getMaxSegments()) _segments.emplace_back(sStart,sStop,sStartY,sStopY); }
     inline void suspend()                                     { _suspend = true; }    // will suspend (and canacel) strip.service() execution
     inline void resume()                                      { _suspend = false; }   // will resume strip.service() execution
+  #ifdef WLED_ENABLE_DETERMINISTIC_RNG
+    void setRandomSeed(uint32_t seed);                                                // sets the seed of deterministic effect randomness, restarts effects
+    inline uint32_t getRandomSeed() const                     { return _rngSeed; }
+  #endif
 
     void restartRuntime();
     void setTransitionMode(bool t);
@@ -931,6 +1176,8 @@ class WS2812FX {
     inline bool isOffRefreshRequired() const { return _isOffRefreshRequired; }  // returns true if strip requires regular updates (i.e. TM1814 chipset)
     inline bool isSuspended() const          { return _suspend; }               // returns true if strip.service() execution is suspended
     inline bool needsUpdate() const          { return _triggered; }             // returns true if strip received a trigger() request
+    bool isIdle();                                                              // returns true while frame is static and strip.service() need not be called
+    uint32_t getIdleFrames() const;                                             // returns number of frames skipped while idle
 
     uint8_t paletteBlend;
     uint8_t getActiveSegmentsNum() const;
@@ -942,7 +1189,7 @@ class WS2812FX {
     inline uint8_t getBrightness() const    { return _brightness; }       // returns current strip brightness
     inline static constexpr unsigned getMaxSegments() { return MAX_NUM_SEGMENTS; }  // returns maximum number of supported segments (fixed value)
     inline uint8_t getSegmentsNum() const   { return _segments.size(); }  // returns currently present segments
-    inline uint8_t getCurrSegmentId() const { return _segment_index; }    // returns current segment index (only valid while strip.isServicing())
+    inline uint8_t getCurrSegmentId() const { return _segment_index; }    // returns index of segment being rendered (only valid while strip.isServicing())
     inline uint8_t getMainSegmentId() const { return _mainSegment; }      // returns main segment index
     inline uint8_t getTargetFps() const     { return _targetFps; }        // returns rough FPS value for las 2s interval
     inline uint8_t getModeCount() const     { return _modeCount; }        // returns number of registered modes/effects
@@ -952,6 +1199,7 @@ class WS2812FX {
 
     inline uint16_t getFps() const          { return (millis() - _lastShow > 2000) ? 0 : (FPS_MULTIPLIER * _cumulativeFps) >> FPS_CALC_SHIFT; } // Returns the refresh rate of the LED strip (_cumulativeFps is stored in fixed point)
     inline uint16_t getFrameTime() const    { return _frametime; }        // returns amount of time a frame should take (in ms)
+    inline uint32_t getFrameTimeUs() const  { return _frameTimeUs; }      // returns frame period of the scheduler (in us)
     inline uint16_t getMinShowDelay() const { return MIN_FRAME_DELAY; }   // returns minimum amount of time strip.service() can be delayed (constant)
     inline uint16_t getLength() const       { return _length; }           // returns actual amount of LEDs on a strip (2D matrix may have less LEDs than W*H)
     inline uint16_t getTransition() const   { return _transitionDur; }    // returns currently set transition time (in ms)
@@ -960,7 +1208,8 @@ class WS2812FX {
       return index;
     };
 
-    unsigned long now, timebase;
+    static WLED_RENDER_LOCAL unsigned long now; // per render task as effects may warp it (see mode_pacifica())
+    unsigned long timebase;
     inline uint32_t getPixelColor(unsigned n) const { return (n < getLengthTotal()) ? _pixels[n] : 0; } // returns color of pixel n
     inline uint32_t getLastShow() const             { return _lastShow; }                 // returns millis() timestamp of last strip.show() call
 
@@ -972,6 +1221,12 @@ class WS2812FX {
     inline Segment& getMainSegment()      { return _segments[getMainSegmentId()]; }       // returns reference to main segment
     inline Segment* getSegments()         { return &(_segments[0]); }                     // returns pointer to segment vector structure (warning: use carefully)
 
+    // render pipeline timing (see TimingStats)
+    inline const segment_timing_t *getSegmentTiming(unsigned id) const { return id < _segmentTiming.size() ? &_segmentTiming[id] : nullptr; }
+    inline const TimingStats      &getPaintTiming() const              { return _paintTiming; }    // gamma correction & copy into bus buffers
+    inline const TimingStats      &getBusShowTiming() const            { return _busShowTiming; }  // BusManager::show()
+    inline const FrameStats       &getFrameStats() const               { return _frameStats; }     // frame scheduler (achieved FPS & jitter)
+
   // 2D support (panels)
 
 #ifndef WLED_DISABLE_2D
@@ -1016,12 +1271,16 @@ class WS2812FX {
       bool cctFromRgb   : 1;
     };
 
-    Segment *_currentSegment;
+    static WLED_RENDER_LOCAL Segment *_currentSegment; // segment being rendered (SEGMENT & SEGENV)
 
   private:
     uint32_t *_pixels;
     uint8_t  *_pixelCCT;
     std::vector<Segment> _segments;
+    std::vector<segment_timing_t> _segmentTiming;
+    TimingStats _paintTiming;
+    TimingStats _busShowTiming;
+    FrameStats  _frameStats;
 
     volatile bool _suspend;
 
@@ -1030,6 +1289,7 @@ class WS2812FX {
     uint16_t _transitionDur;
 
     uint16_t _frametime;
+    uint32_t _frameTimeUs;      // frame period (MIN_FRAME_DELAY in unlimited mode)
     uint16_t _cumulativeFps;
     uint8_t  _targetFps;
 
@@ -1039,10 +1299,14 @@ class WS2812FX {
       bool _isOffRefreshRequired : 1; //periodic refresh is required for the strip to remain off.
       bool _hasWhiteChannel      : 1;
       bool _triggered            : 1;
+      bool _pixelCCTDirty        : 1; // _pixelCCT contains non-neutral values
+      bool _frameValid           : 1; // _pixels holds composited segments that were sent to LEDs
+      bool _idle                 : 1; // frame is static, loop() does not call service() (see isIdle())
     };
 
-    uint8_t _segment_index;
+    static WLED_RENDER_LOCAL uint8_t _segment_index;
     uint8_t _mainSegment;
+    uint8_t _blendedSegments;   // number of segments blended into last composited frame
 
     uint8_t                  _modeCount;
     std::vector<mode_ptr>    _mode;     // SRAM footprint: 4 bytes per element
@@ -1054,7 +1318,61 @@ class WS2812FX {
     uint16_t  customMappingSize;
 
     unsigned long _lastShow;
-    unsigned long _lastServiceShow;
+    unsigned long _lastServiceShow;   // micros() of last frame rendered by service()
+    unsigned long _nextFrameUs;       // micros() deadline of next frame
+    unsigned long _idleSince;         // millis() when strip became idle
+    uint32_t      _idleFrames;        // frames skipped in completed idle periods
+
+  #ifdef WLED_ENABLE_DETERMINISTIC_RNG
+    uint32_t _rngSeed = 0;
+  #endif
+
+#ifdef WLED_ENABLE_PIPELINED_OUTPUT
+    // frame handed over to the output task (copy of _pixels/_pixelCCT, see service())
+    uint32_t *_outPixels;
+    uint8_t  *_outPixelCCT;
+    int16_t   _outCCT;        // CCT for paintFrame() (_outPixelCCT is used if CCT_PER_PIXEL)
+    TaskHandle_t      _outputTask;
+    SemaphoreHandle_t _outputStart;
+    SemaphoreHandle_t _outputDone;
+    bool              _outputPending; // frame is in _outPixels but not sent yet
+    bool              _outputBusy;    // output task is sending a frame
+
+    static void outputTask(void *param);
+    void startOutput();
+    void waitForOutput();
+    bool queueFrame();
+#endif
+
+#ifdef WLED_ENABLE_PARALLEL_RENDER
+    // segments due in current frame are queued by service() and picked up by loop() and render tasks
+    typedef struct {
+      WS2812FX         *strip;
+      TaskHandle_t      handle;
+      SemaphoreHandle_t start;
+      SemaphoreHandle_t done;
+    } render_task_t;
+    render_task_t         _renderTasks[WLED_RENDER_TASKS];
+    uint8_t               _renderQueue[MAX_NUM_SEGMENTS];
+    uint8_t               _renderCount;
+    std::atomic<unsigned> _renderNext; // next queue entry to render
+    unsigned long         _renderNow;
+  #ifdef WLED_ENABLE_DETERMINISTIC_RNG
+    uint32_t              _renderRndState;   // random stream left by last queued segment (serial rendering continues with it)
+    uint16_t              _renderRnd16State;
+  #endif
+
+    static void renderTask(void *param);
+    void renderQueued();
+    void renderParallel(unsigned long nowUp);
+#endif
+
+    void renderSegment(Segment &seg, unsigned long nowUp); // runs segment's effect (and old effect during transition)
+    bool hasFrameChanged(unsigned long nowUp) const; // true if segments need to be composited and sent to LEDs
+    bool isFrameStatic() const;                      // true if rendering segments again would not change the frame
+    int  composeFrame();                             // blends segments into _pixels (and _pixelCCT), returns CCT for paintFrame()
+    void paintFrame(const uint32_t *pixels, const uint8_t *pixelCCT, int cct); // sends pixels to LEDs
+    void updateFps(unsigned long showNow);
 
     friend class Segment;
 };
@@ -52,7 +52,7 @@ void WS2812FX::setUpMatrix() {
     customMappingSize = 0; // prevent use of mapping if anything goes wrong
 
     d_free(customMappingTable);
-    customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // prefer to not use SPI RAM
+    customMappingTable = static_cast<uint16_t*>(tagAllocation(d_malloc(sizeof(uint16_t)*getLengthTotal()), ALLOC_TAG_LEDMAP)); // prefer to not use SPI RAM
 
     if (customMappingTable) {
       customMappingSize = getLengthTotal();
@@ -86,7 +86,7 @@ void WS2812FX::setUpMatrix() {
           JsonArray map = pDoc->as<JsonArray>();
           gapSize = map.size();
           if (!map.isNull() && gapSize >= matrixSize) { // not an empty map
-            gapTable = static_cast<int8_t*>(p_malloc(gapSize));
+            gapTable = static_cast<int8_t*>(tagAllocation(p_malloc(gapSize), ALLOC_TAG_LEDMAP));
             if (gapTable) for (size_t i = 0; i < gapSize; i++) {
               gapTable[i] = constrain(map[i], -1, 1);
             }
@@ -37,20 +37,24 @@
 ///////////////////////////////////////////////////////////////////////////////
 // Segment class implementation
 ///////////////////////////////////////////////////////////////////////////////
+#ifdef WLED_ENABLE_PARALLEL_RENDER
+std::atomic<unsigned> Segment::_usedSegmentData(0U); // amount of RAM all segments use for their data[]
+#else
 unsigned      Segment::_usedSegmentData   = 0U; // amount of RAM all segments use for their data[]
-uint16_t      Segment::maxWidth           = DEFAULT_LED_COUNT;
-uint16_t      Segment::maxHeight          = 1;
 unsigned      Segment::_vLength           = 0;
 unsigned      Segment::_vWidth            = 0;
 unsigned      Segment::_vHeight           = 0;
 uint32_t      Segment::_currentColors[NUM_COLORS] = {0,0,0};
 CRGBPalette16 Segment::_currentPalette    = CRGBPalette16(CRGB::Black);
+bool          Segment::_modeBlend         = false;
+#endif
+uint16_t      Segment::maxWidth           = DEFAULT_LED_COUNT;
+uint16_t      Segment::maxHeight          = 1;
 CRGBPalette16 Segment::_randomPalette     = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
 CRGBPalette16 Segment::_newRandomPalette  = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
 uint16_t      Segment::_lastPaletteChange = 0; // in seconds; perhaps it should be per segment
 uint16_t      Segment::_nextPaletteBlend  = 0; // in millis
 
-bool     Segment::_modeBlend = false;
 uint16_t Segment::_clipStart = 0;
 uint16_t Segment::_clipStop = 0;
 uint8_t  Segment::_clipStartY = 0;
@@ -61,18 +65,27 @@ Segment::Segment(const Segment &orig) {
   //DEBUG_PRINTF_P(PSTR("-- Copy segment constructor: %p -> %p\n"), &orig, this);
   memcpy((void*)this, (void*)&orig, sizeof(Segment));
   _t   = nullptr; // copied segment cannot be in transition
+  _dirty = true;
+  _snapshot = false;
   name = nullptr;
   data = nullptr;
   _dataLen = 0;
   pixels = nullptr;
+  #ifndef WLED_DISABLE_2D
+  _m12map = nullptr;
+  #endif
+  #ifndef WLED_DISABLE_PALETTE_LUT
+  _paletteLUT = nullptr;
+  #endif
   if (!stop) return;  // nothing to do if segment is inactive/invalid
   if (orig.pixels) {
     // allocate pixel buffer: prefer IRAM/PSRAM
-    pixels = static_cast<uint32_t*>(allocate_buffer(orig.length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
+    pixels = static_cast<uint32_t*>(allocate_buffer(orig.length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_TAG(ALLOC_TAG_SEGPIXELS)));
     if (pixels) {
       memcpy(pixels, orig.pixels, sizeof(uint32_t) * orig.length());
-      if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM)); if (name) strcpy(name, orig.name); }
+      if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM | BFRALLOC_TAG(ALLOC_TAG_SEGNAME))); if (name) strcpy(name, orig.name); }
       if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
+      copyMapping1D2D(orig);
     } else {
       DEBUGFX_PRINTLN(F("!!! Not enough RAM for pixel buffer !!!"));
       errorFlag = ERR_NORAM_PX;
@@ -81,6 +94,24 @@ Segment::Segment(const Segment &orig) {
   } else stop = 0; // mark segment as inactive/invalid
 }
 
+// transition snapshot (old segment): unlike copy constructor does not duplicate pixel and effect data buffers
+// they are borrowed from the live segment until it is about to change them (see detachOldSegment())
+// so transitions that do not run the old effect (e.g. brightness or color fade) need no extra buffers
+Segment::Segment(const Segment &orig, snapshot_t) {
+  memcpy((void*)this, (void*)&orig, sizeof(Segment));
+  _t   = nullptr; // copied segment cannot be in transition
+  _dirty = true;
+  _snapshot = true;
+  name = nullptr;
+  #ifndef WLED_DISABLE_2D
+  _m12map = nullptr;
+  #endif
+  #ifndef WLED_DISABLE_PALETTE_LUT
+  _paletteLUT = nullptr;
+  #endif
+  if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM | BFRALLOC_TAG(ALLOC_TAG_TRANSITION))); if (name) strcpy(name, orig.name); }
+}
+
 // move constructor
 Segment::Segment(Segment &&orig) noexcept {
   //DEBUG_PRINTF_P(PSTR("-- Move segment constructor: %p -> %p\n"), &orig, this);
@@ -90,6 +121,12 @@ Segment::Segment(Segment &&orig) noexcept {
   orig.data = nullptr;
   orig._dataLen = 0;
   orig.pixels = nullptr;
+  #ifndef WLED_DISABLE_2D
+  orig._m12map = nullptr;
+  #endif
+  #ifndef WLED_DISABLE_PALETTE_LUT
+  orig._paletteLUT = nullptr;
+  #endif
 }
 
 // copy assignment
@@ -100,22 +137,33 @@ Segment& Segment::operator= (const Segment &orig) {
     if (name) { p_free(name); name = nullptr; }
     if (_t) stopTransition(); // also erases _t
     deallocateData();
+    freeMapping1D2D();
+    freePaletteLUT();
     p_free(pixels);
     // copy source
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
+    _dirty = true;
+    _snapshot = false;
     // erase pointers to allocated data
     data = nullptr;
     _dataLen = 0;
     pixels = nullptr;
+    #ifndef WLED_DISABLE_2D
+    _m12map = nullptr;
+    #endif
+    #ifndef WLED_DISABLE_PALETTE_LUT
+    _paletteLUT = nullptr;
+    #endif
     if (!stop) return *this;  // nothing to do if segment is inactive/invalid
     // copy source data
     if (orig.pixels) {
       // allocate pixel buffer: prefer IRAM/PSRAM
-      pixels = static_cast<uint32_t*>(allocate_buffer(orig.length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
+      pixels = static_cast<uint32_t*>(allocate_buffer(orig.length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_TAG(ALLOC_TAG_SEGPIXELS)));
       if (pixels) {
         memcpy(pixels, orig.pixels, sizeof(uint32_t) * orig.length());
-        if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM)); if (name) strcpy(name, orig.name); }
+        if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM | BFRALLOC_TAG(ALLOC_TAG_SEGNAME))); if (name) strcpy(name, orig.name); }
         if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
+        copyMapping1D2D(orig);
       } else {
         DEBUG_PRINTLN(F("!!! Not enough RAM for pixel buffer !!!"));
         errorFlag = ERR_NORAM_PX;
@@ -133,6 +181,8 @@ Segment& Segment::operator= (Segment &&orig) noexcept {
     if (name) { p_free(name); name = nullptr; } // free old name
     if (_t) stopTransition(); // also erases _t
     deallocateData(); // free old runtime data
+    freeMapping1D2D();
+    freePaletteLUT();
     p_free(pixels);   // free old pixel buffer
     // move source data
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
@@ -140,6 +190,12 @@ Segment& Segment::operator= (Segment &&orig) noexcept {
     orig.data = nullptr;
     orig._dataLen = 0;
     orig.pixels = nullptr;
+    #ifndef WLED_DISABLE_2D
+    orig._m12map = nullptr;
+    #endif
+    #ifndef WLED_DISABLE_PALETTE_LUT
+    orig._paletteLUT = nullptr;
+    #endif
     orig._t = nullptr; // old segment cannot be in transition
   }
   return *this;
@@ -175,7 +231,7 @@ bool Segment::allocateData(size_t len) {
     Segment::addUsedSegmentData(-_dataLen); // subtract buffer size
   }
 
-  data = static_cast<byte*>(allocate_buffer(len, BFRALLOC_PREFER_DRAM | BFRALLOC_CLEAR)); // prefer DRAM over PSRAM for speed
+  data = static_cast<byte*>(allocate_buffer(len, BFRALLOC_PREFER_DRAM | BFRALLOC_CLEAR | BFRALLOC_TAG(ALLOC_TAG_SEGDATA))); // prefer DRAM over PSRAM for speed
 
   if (data) {
     Segment::addUsedSegmentData(len);
@@ -211,6 +267,7 @@ void Segment::deallocateData() {
   */
 void Segment::resetIfRequired() {
   if (!reset || !isActive()) return;
+  detachOldSegment();
   //DEBUG_PRINTF_P(PSTR("-- Segment reset: %p\n"), this);
   if (data && _dataLen > 0) {
     if (_dataLen > FAIR_DATA_PER_SEG) deallocateData(); // do not keep large allocations
@@ -218,6 +275,7 @@ void Segment::resetIfRequired() {
     DEBUG_PRINTF_P(PSTR("-- Segment %p reset, data cleared\n"), this);
   }
   if (pixels) for (size_t i = 0; i < length(); i++) pixels[i] = BLACK; // clear pixel buffer
+  _dirty = true;
   next_time = 0; step = 0; call = 0; aux0 = 0; aux1 = 0;
   reset = false;
   #ifdef WLED_ENABLE_GIF
@@ -284,9 +342,10 @@ void Segment::startTransition(uint16_t dur, bool segmentCopy) {
     return;
   }
   if (isInTransition()) {
-    if (segmentCopy && !_t->_oldSegment) {
-      // already in transition but segment copy requested and not yet created
-      _t->_oldSegment = new(std::nothrow) Segment(*this); // store/copy current segment settings
+    if (segmentCopy && !getOldSegment()) {
+      // already in transition but segment copy requested and not yet created (or dropped its buffers, see detachOldSegment())
+      delete _t->_oldSegment;
+      _t->_oldSegment = new(std::nothrow) Segment(*this, snapshot_t()); // store/copy current segment settings
       _t->_start = millis();                              // restart countdown
       _t->_dur   = dur;
       _t->_prevPaletteBlends = 0;
@@ -310,7 +369,7 @@ void Segment::startTransition(uint16_t dur, bool segmentCopy) {
     loadPalette(_t->_palT, palette);
     #endif
     for (int i=0; i<NUM_COLORS; i++) _t->_colors[i] = colors[i];
-    if (segmentCopy) _t->_oldSegment = new(std::nothrow) Segment(*this); // store/copy current segment settings
+    if (segmentCopy) _t->_oldSegment = new(std::nothrow) Segment(*this, snapshot_t()); // store/copy current segment settings
     if (_t->_oldSegment) {
       DEBUGFX_PRINTF_P(PSTR("-- Started transition: S=%p T(%p) O[%p] OP[%p]\n"), this, _t, _t->_oldSegment, _t->_oldSegment->pixels);
       if (!_t->_oldSegment->isActive()) stopTransition();
@@ -320,10 +379,39 @@ void Segment::startTransition(uint16_t dur, bool segmentCopy) {
   };
 }
 
+// true if the old effect of a transition still has to run (it needs its own pixels and data)
+static bool isOldModeRunning(const Segment &seg, const Segment &segO) {
+  return seg.mode != segO.mode || blendingStyle != BLEND_STYLE_FADE ||
+         (segO.name != seg.name && segO.name && seg.name && strncmp(segO.name, seg.name, WLED_MAX_SEGNAME_LEN) != 0);
+}
+
+// ends borrowing of pixel and data buffers by the old segment (transition snapshot)
+// if the old effect has to keep running it gets its own copy, otherwise it is left without buffers
+void Segment::detachOldSegment() {
+  Segment *segO = isInTransition() ? _t->_oldSegment : nullptr;
+  if (!segO || !segO->_snapshot) return;
+  segO->_snapshot = false;
+  segO->pixels    = nullptr;
+  segO->data      = nullptr;
+  segO->_dataLen  = 0;
+  if (!isActive() || !isOldModeRunning(*this, *segO)) return;
+  segO->pixels = static_cast<uint32_t*>(allocate_buffer(length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_TAG(ALLOC_TAG_TRANSITION)));
+  if (!segO->pixels) {
+    DEBUGFX_PRINTLN(F("!!! Not enough RAM for transition pixel buffer !!!")); // transition continues without old effect
+    return;
+  }
+  memcpy(segO->pixels, pixels, length() * sizeof(uint32_t));
+  if (data && segO->allocateData(_dataLen)) memcpy(segO->data, data, _dataLen);
+  segO->copyMapping1D2D(*this);
+  segO->tagAllocations(ALLOC_TAG_TRANSITION);
+  DEBUGFX_PRINTF_P(PSTR("-- Detached old segment: S=%p O[%p] OP[%p]\n"), this, segO, segO->pixels);
+}
+
 void Segment::stopTransition() {
   DEBUG_PRINTF_P(PSTR("-- Stopping transition: S=%p T(%p) O[%p]\n"), this, _t, _t->_oldSegment);
   delete _t;
   _t = nullptr;
+  _dirty = true; // last frame of transition may not have been shown yet
 }
 
 // sets transition progress variable (0-65535) based on time passed since transition start
@@ -341,7 +429,7 @@ uint8_t Segment::currentCCT() const {
   unsigned prog = progress();
   if (prog < 0xFFFFU) {
     if (blendingStyle == BLEND_STYLE_FADE) return (cct * prog + (_t->_cct * (0xFFFFU - prog))) / 0xFFFFU;
-    //else                                   return Segment::isPreviousMode() ? _t->_cct : cct;
+    //else                                   return isPreviousMode() ? _t->_cct : cct;
   }
   return cct;
 }
@@ -353,21 +441,35 @@ uint8_t Segment::currentBri() const {
   if (prog < 0xFFFFU) {
     // this will blend opacity in new mode if style is FADE (single effect call)
     if (blendingStyle == BLEND_STYLE_FADE) curBri = (prog * curBri + _t->_bri * (0xFFFFU - prog)) / 0xFFFFU;
-    else                                   curBri = Segment::isPreviousMode() ? _t->_bri : curBri;
+    else                                   curBri = isPreviousMode() ? _t->_bri : curBri;
   }
   return curBri;
 }
 
+#ifndef WLED_DISABLE_PALETTE_LUT
+// FNV-1a checksum of palette entries, identifies the palette a segment's LUT was filled from
+static uint32_t paletteHash(const CRGBPalette16 &pal) {
+  uint32_t hash = 2166136261UL;
+  for (unsigned i = 0; i < 16; i++) {
+    hash = (hash ^ pal.entries[i].r) * 16777619UL;
+    hash = (hash ^ pal.entries[i].g) * 16777619UL;
+    hash = (hash ^ pal.entries[i].b) * 16777619UL;
+  }
+  return hash;
+}
+#endif
+
 // pre-calculate drawing parameters for faster access (based on the idea from @softhack007 from MM fork)
 // and blends colors and palettes if necessary
 // prog is the progress of the transition (0-65535) and is passed to the function as it may be called in the context of old segment
 // which does not have transition structure
 void Segment::beginDraw(uint16_t prog) {
   setDrawDimensions();
+  updateMapping1D2D();
   // load colors into _currentColors
   for (unsigned i = 0; i < NUM_COLORS; i++) _currentColors[i] = colors[i];
   // load palette into _currentPalette
-  loadPalette(Segment::_currentPalette, palette);
+  loadPalette(_currentPalette, palette);
   if (isInTransition() && prog < 0xFFFFU && blendingStyle == BLEND_STYLE_FADE) {
     // blend colors
     for (unsigned i = 0; i < NUM_COLORS; i++) _currentColors[i] = color_blend16(_t->_colors[i], colors[i], prog);
@@ -377,16 +479,23 @@ void Segment::beginDraw(uint16_t prog) {
     #ifndef WLED_SAVE_RAM
     unsigned noOfBlends = ((255U * prog) / 0xFFFFU) - _t->_prevPaletteBlends;
     if(noOfBlends > 255) noOfBlends = 255; // safety check
-    for (unsigned i = 0; i < noOfBlends; i++, _t->_prevPaletteBlends++) nblendPaletteTowardPalette(_t->_palT, Segment::_currentPalette, 48);
-    Segment::_currentPalette = _t->_palT; // copy transitioning/temporary palette
+    for (unsigned i = 0; i < noOfBlends; i++, _t->_prevPaletteBlends++) nblendPaletteTowardPalette(_t->_palT, _currentPalette, 48);
+    _currentPalette = _t->_palT; // copy transitioning/temporary palette
     #else
     unsigned noOfBlends = ((255U * prog) / 0xFFFFU);
     CRGBPalette16 tmpPalette;
     loadPalette(tmpPalette, _t->_palette);
-    for (unsigned i = 0; i < noOfBlends; i++) nblendPaletteTowardPalette(tmpPalette, Segment::_currentPalette, 48);
-    Segment::_currentPalette = tmpPalette; // copy transitioning/temporary palette
+    for (unsigned i = 0; i < noOfBlends; i++) nblendPaletteTowardPalette(tmpPalette, _currentPalette, 48);
+    _currentPalette = tmpPalette; // copy transitioning/temporary palette
     #endif
   }
+  #ifndef WLED_DISABLE_PALETTE_LUT
+  // compare with this segment's own last palette (_currentPalette is shared by all segments unless WLED_ENABLE_PARALLEL_RENDER)
+  const uint32_t palHash = paletteHash(_currentPalette);
+  if (_paletteLUT && palHash != _paletteLUTHash) memset(_paletteLUT, 0, 256 * sizeof(uint32_t)); // palette changed (or is blending)
+  _paletteLUTHash = palHash;
+  _paletteLUTFailed = false;
+  #endif
 }
 
 // relies on WS2812FX::service() to call it for each frame
@@ -414,7 +523,7 @@ void Segment::handleRandomPalette() {
 
 // sets Segment geometry (length or width/height and grouping, spacing and offset as well as 2D mapping)
 // strip must be suspended (strip.suspend()) before calling this function
-// this function may call fill() to clear pixels if spacing or mapping changed (which requires setting _vWidth, _vHeight, _vLength or beginDraw())
+// this function may call fill() to clear pixels if spacing or mapping changed (draw dimensions are refreshed before that)
 void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, uint16_t ofs, uint16_t i1Y, uint16_t i2Y, uint8_t m12) {
   // return if neither bounds nor grouping have changed
   bool boundsUnchanged = (start == i1 && stop == i2);
@@ -423,7 +532,8 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
   #endif
   boundsUnchanged &= (grouping == grp && spacing == spc); // changing grouping and/or spacing changes virtual segment length (painting dimensions)
 
-  if (stop && (spc > 0 || m12 != map1D2D)) clear();
+  detachOldSegment();
+  if (stop && (spc > 0 || m12 != map1D2D)) { setDrawDimensions(); clear(); }
   if (grp) { // prevent assignment of 0
     grouping = grp;
     spacing = spc;
@@ -434,7 +544,7 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
   if (ofs < UINT16_MAX) offset = ofs;
   map1D2D  = constrain(m12, 0, 7);
 
-  if (boundsUnchanged) return;
+  if (boundsUnchanged) { setDrawDimensions(); return; } // mapping may still have changed
 
   unsigned oldLength = length();
 
@@ -446,6 +556,7 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
   // apply change immediately
   if (i2 <= i1) { //disable segment
     deallocateData();
+    freeMapping1D2D();
     p_free(pixels);
     pixels = nullptr;
     stop = 0;
@@ -464,6 +575,7 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
   // safety check
   if (start >= stop || startY >= stopY) {
     deallocateData();
+    freeMapping1D2D();
     p_free(pixels);
     pixels = nullptr;
     stop = 0;
@@ -473,7 +585,7 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
   if (length() != oldLength) {
     // allocate render buffer (always entire segment), prefer IRAM/PSRAM. Note: impact on FPS with PSRAM buffer is low (<2% with QSPI PSRAM) on S2/S3
     p_free(pixels);
-    pixels = static_cast<uint32_t*>(allocate_buffer(length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
+    pixels = static_cast<uint32_t*>(allocate_buffer(length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_TAG(ALLOC_TAG_SEGPIXELS)));
     if (!pixels) {
       DEBUGFX_PRINTLN(F("!!! Not enough RAM for pixel buffer !!!"));
       deallocateData();
@@ -484,6 +596,7 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
 
   }
   refreshLightCapabilities();
+  setDrawDimensions();
 }
 
 
@@ -496,6 +609,7 @@ Segment &Segment::setColor(uint8_t slot, uint32_t c) {
   //DEBUG_PRINTF_P(PSTR("- Starting color transition: %d [0x%X]\n"), slot, c);
   startTransition(strip.getTransition(), blendingStyle != BLEND_STYLE_FADE); // start transition prior to change
   colors[slot] = c;
+  _dirty = true;     // segment must be rendered again (ends strip idle, see WS2812FX::isIdle())
   stateChanged = true; // send UDP/WS broadcast
   return *this;
 }
@@ -510,6 +624,7 @@ Segment &Segment::setCCT(uint16_t k) {
     //DEBUG_PRINTF_P(PSTR("- Starting CCT transition: %d\n"), k);
     startTransition(strip.getTransition(), false); // start transition prior to change (no need to copy segment)
     cct = k;
+    _dirty = true;
     stateChanged = true; // send UDP/WS broadcast
   }
   return *this;
@@ -520,6 +635,7 @@ Segment &Segment::setOpacity(uint8_t o) {
     //DEBUG_PRINTF_P(PSTR("- Starting opacity transition: %d\n"), o);
     startTransition(strip.getTransition(), blendingStyle != BLEND_STYLE_FADE); // start transition prior to change
     opacity = o;
+    _dirty = true;
     stateChanged = true; // send UDP/WS broadcast
   }
   return *this;
@@ -532,6 +648,8 @@ Segment &Segment::setOption(uint8_t n, bool val) {
   if (n == SEG_OPTION_ON) startTransition(strip.getTransition(), blendingStyle != BLEND_STYLE_FADE); // start transition prior to change
   if (val) options |=   0x01 << n;
   else     options &= ~(0x01 << n);
+  setDrawDimensions(); // transpose/mirror change virtual dimensions
+  _dirty = true;
   stateChanged = true; // send UDP/WS broadcast
   return *this;
 }
@@ -579,6 +697,7 @@ Segment &Segment::setPalette(uint8_t pal) {
     //DEBUG_PRINTF_P(PSTR("- Starting palette transition: %d\n"), pal);
     startTransition(strip.getTransition(), blendingStyle != BLEND_STYLE_FADE); // start transition prior to change (no need to copy segment)
     palette = pal;
+    _dirty = true;
     stateChanged = true; // send UDP/WS broadcast
   }
   return *this;
@@ -589,7 +708,7 @@ Segment &Segment::setName(const char *newName) {
     const int newLen = min(strlen(newName), (size_t)WLED_MAX_SEGNAME_LEN);
     if (newLen) {
       if (name) p_free(name); // free old name
-      name = static_cast<char*>(allocate_buffer(newLen+1, BFRALLOC_PREFER_PSRAM));
+      name = static_cast<char*>(allocate_buffer(newLen+1, BFRALLOC_PREFER_PSRAM | BFRALLOC_TAG(ALLOC_TAG_SEGNAME)));
       if (mode == FX_MODE_2DSCROLLTEXT) startTransition(strip.getTransition(), true); // if the name changes in scrolling text mode, we need to copy the segment for blending
       if (name) strlcpy(name, newName, newLen+1);
       return *this;
@@ -635,6 +754,270 @@ static void setPinwheelParameters(int i, int vW, int vH, int& startx, int& start
   startx = (vW * Fixed_Scale) / 2; // + cosVal[0] / 4; // starting position = center + 1/4 pixel (in fixed point)
   starty = (vH * Fixed_Scale) / 2; // + sinVal[0] / 4;
 }
+
+static WLED_RENDER_LOCAL int pinwheelPrevRays[2] = {INT_MAX, INT_MAX}; // previous two ray numbers (per render task)
+
+// returns which edge lines of pinwheel ray i need drawing considering previously drawn rays (as an index into 8 states)
+// bit 0: draw first line, bit 1: draw last line, bit 2: ray drawn twice in one frame
+static unsigned getPinwheelState(int i, int vW, int vH) {
+  int max_i = getPinwheelLength(vW, vH) - 1;
+  bool drawFirst = !(pinwheelPrevRays[0] == i - 1 || (i == 0 && pinwheelPrevRays[0] == max_i)); // draw first line if previous ray was not adjacent including wrap
+  bool drawLast  = !(pinwheelPrevRays[0] == i + 1 || (i == max_i && pinwheelPrevRays[0] == 0)); // same as above for last line
+  bool drawTwice = (i == pinwheelPrevRays[1]);
+  pinwheelPrevRays[1] = pinwheelPrevRays[0];
+  pinwheelPrevRays[0] = i;
+  return drawFirst | (drawLast << 1) | (drawTwice << 2);
+}
+
+// pixels of 1D pixel i in arc mapping mode, plot(x,y) may receive coordinates outside of segment
+template<typename F> static void arcPixels(int i, F plot) {
+  // expand in circular fashion from center
+  if (i == 0) {
+    plot(0, 0);
+    return;
+  }
+  float r = i;
+  float step = HALF_PI / (2.8284f * r + 4); // we only need (PI/4)/(r/sqrt(2)+1) steps
+  for (float rad = 0.0f; rad <= (HALF_PI/2)+step/2; rad += step) {
+    int x = roundf(sin_t(rad) * r);
+    int y = roundf(cos_t(rad) * r);
+    // exploit symmetry
+    plot(x, y);
+    plot(y, x);
+  }
+  // Bresenham’s Algorithm (may not fill every pixel)
+  //int d = 3 - (2*i);
+  //int y = i, x = 0;
+  //while (y >= x) {
+  //  plot(x, y);
+  //  plot(y, x);
+  //  x++;
+  //  if (d > 0) {
+  //    y--;
+  //    d += 4 * (x - y) + 10;
+  //  } else {
+  //    d += 4 * x + 6;
+  //  }
+  //}
+}
+
+// pixels of 1D pixel i in corner mapping mode, plot(x,y) may receive coordinates outside of segment
+template<typename F> static void cornerPixels(int i, F plot) {
+  for (int x = 0; x <= i; x++) plot(x, i); // note: <= to include i=0
+  for (int y = 0; y <  i; y++) plot(i, y);
+}
+
+// pixels of ray i in pinwheel mapping mode for the given state (see getPinwheelState())
+template<typename F> static void pinwheelPixels(int i, int vW, int vH, unsigned state, F plot) {
+  // Uses Bresenham's algorithm to place coordinates of two lines in arrays then draws between them
+  int startX, startY, cosVal[2], sinVal[2]; // in fixed point scale
+  setPinwheelParameters(i, vW, vH, startX, startY, cosVal, sinVal);
+
+  unsigned maxLineLength = max(vW, vH) + 2; // pixels drawn is always smaller than dx or dy, +1 pair for rounding errors
+  uint16_t lineCoords[2][maxLineLength];    // uint16_t to save ram
+  int lineLength[2] = {0};
+
+  int closestEdgeIdx = INT_MAX; // index of the closest edge pixel
+
+  for (int lineNr = 0; lineNr < 2; lineNr++) {
+    int x0 = startX; // x, y coordinates in fixed scale
+    int y0 = startY;
+    int x1 = (startX + (cosVal[lineNr] << 9)); // outside of grid
+    int y1 = (startY + (sinVal[lineNr] << 9)); // outside of grid
+    const int dx =  abs(x1-x0), sx = x0<x1 ? 1 : -1; // x distance & step
+    const int dy = -abs(y1-y0), sy = y0<y1 ? 1 : -1; // y distance & step
+    uint16_t* coordinates = lineCoords[lineNr]; // 1D access is faster
+    int* length = &lineLength[lineNr];          // faster access
+    x0 /= Fixed_Scale; // convert to pixel coordinates
+    y0 /= Fixed_Scale;
+
+    // Bresenham's algorithm
+    int idx = 0;
+    int err = dx + dy;
+    while (true) {
+      if ((unsigned)x0 >= (unsigned)vW || (unsigned)y0 >= (unsigned)vH) {
+        closestEdgeIdx = min(closestEdgeIdx, idx-2);
+        break; // stop if outside of grid (exploit unsigned int overflow)
+      }
+      coordinates[idx++] = x0;
+      coordinates[idx++] = y0;
+      (*length)++;
+      // note: since endpoint is out of grid, no need to check if endpoint is reached
+      int e2 = 2 * err;
+      if (e2 >= dy) { err += dy; x0 += sx; }
+      if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+  }
+
+  // fill up the shorter line with missing coordinates, so block filling works correctly and efficiently
+  int diff = lineLength[0] - lineLength[1];
+  int longLineIdx = (diff > 0) ? 0 : 1;
+  int shortLineIdx = longLineIdx ? 0 : 1;
+  if (diff != 0) {
+    int idx = (lineLength[shortLineIdx] - 1) * 2; // last valid coordinate index
+    int lastX = lineCoords[shortLineIdx][idx++];
+    int lastY = lineCoords[shortLineIdx][idx++];
+    bool keepX = lastX == 0 || lastX == vW - 1;
+    for (int d = 0; d < abs(diff); d++) {
+      lineCoords[shortLineIdx][idx] = keepX ? lastX :lineCoords[longLineIdx][idx];
+      idx++;
+      lineCoords[shortLineIdx][idx] =  keepX ? lineCoords[longLineIdx][idx] : lastY;
+      idx++;
+    }
+  }
+
+  // draw and block-fill the line coordinates. Note: block filling only efficient if angle between lines is small
+  closestEdgeIdx += 2;
+  bool drawFirst = state & 1;
+  bool drawLast  = state & 2;
+  bool drawTwice = state & 4;
+  for (int idx = 0; idx < lineLength[longLineIdx] * 2;) { //!! should be long line idx!
+    int x1 = lineCoords[0][idx];
+    int x2 = lineCoords[1][idx++];
+    int y1 = lineCoords[0][idx];
+    int y2 = lineCoords[1][idx++];
+    int minX, maxX, minY, maxY;
+    (x1 < x2) ? (minX = x1, maxX = x2) : (minX = x2, maxX = x1);
+    (y1 < y2) ? (minY = y1, maxY = y2) : (minY = y2, maxY = y1);
+
+    // fill the block between the two x,y points
+    bool alwaysDraw = (drawFirst && drawLast) || // No adjacent rays, draw all pixels
+                      (idx > closestEdgeIdx)  || // Edge pixels on uneven lines are always drawn
+                      (i == 0 && idx == 2)    || // Center pixel special case
+                      drawTwice;                 // Effect drawing twice in 1 frame
+    for (int x = minX; x <= maxX; x++) {
+      for (int y = minY; y <= maxY; y++) {
+        bool onLine1 = x == x1 && y == y1;
+        bool onLine2 = x == x2 && y == y2;
+        if ((alwaysDraw) ||
+            (!onLine1 && (!onLine2 || drawLast))  || // Middle pixels and line2 if drawLast
+            (!onLine2 && (!onLine1 || drawFirst))    // Middle pixels and line1 if drawFirst
+          ) {
+          plot(x, y);
+        }
+      }
+    }
+  }
+}
+
+// pixel read by getPixelColor() for 1D pixel i in arc, corner and pinwheel mapping modes (may be outside of segment)
+static void getMappedPixelXY(unsigned m12, int i, int vW, int vH, int &x, int &y) {
+  x = y = 0;
+  switch (m12) {
+    case M12_pArc:
+      if (i > vW && i > vH) {
+        x = y = sqrt32_bw(i*i/2);
+        break; // use diagonal
+      }
+      // otherwise fallthrough
+    case M12_pCorner:
+      // use longest dimension
+      if (vW > vH) x = i;
+      else         y = i;
+      break;
+    case M12_sPinwheel: {
+      // not 100% accurate, returns pixel at outer edge
+      int cosVal[2], sinVal[2];
+      setPinwheelParameters(i, vW, vH, x, y, cosVal, sinVal, true);
+      int maxX = (vW-1) * Fixed_Scale;
+      int maxY = (vH-1) * Fixed_Scale;
+      // trace ray from center until we hit any edge - to avoid rounding problems, we use fixed point coordinates
+      while ((x < maxX)  && (y < maxY) && (x > Fixed_Scale) && (y > Fixed_Scale)) {
+        x += cosVal[0]; // advance to next position
+        y += sinVal[0];
+      }
+      x /= Fixed_Scale;
+      y /= Fixed_Scale;
+      break;
+    }
+  }
+}
+
+// builds the expansion map used by setPixelColor()/getPixelColor() for arc, corner and pinwheel mapping
+// the map lists segment pixels for every 1D pixel (pinwheel: for every state, see getPinwheelState()) so that the
+// geometry is only calculated when mapping or virtual dimensions change and not on every setPixelColor() call
+// called from beginDraw(), falls back to calculation on the fly if there is not enough RAM
+void Segment::updateMapping1D2D() {
+  const unsigned m12 = map1D2D;
+  if (!isActive() || !is2D() || (m12 != M12_pArc && m12 != M12_pCorner && m12 != M12_sPinwheel)) {
+    freeMapping1D2D();
+    return;
+  }
+  const int vW = vWidth();
+  const int vH = vHeight();
+  const int vL = vLength();
+  if (_m12map && _m12map->isFor(m12, vW, vH)) return; // up to date
+  freeMapping1D2D();
+  // do not rebuild the temporary tables every frame if the map cannot be stored, until geometry changes
+  const uint32_t key = (m12 << 28) | ((vW & 0x3FFF) << 14) | (vH & 0x3FFF);
+  if (key == _m12mapFailed) return;
+  _m12mapFailed = key;
+
+  std::vector<uint16_t> runs;
+  std::vector<uint16_t> touched; // pixels of current 1D pixel in order of appearance
+  std::vector<uint8_t>  masks(vW * vH, 0); // states in which pixel is drawn
+  std::vector<uint16_t> starts(vL + 1), reverse(vL);
+  runs.reserve(vW * vH + vL * 4);
+  for (int i = 0; i < vL; i++) {
+    touched.clear();
+    auto plot = [&](int x, int y, uint8_t states) {
+      if ((unsigned)x >= (unsigned)vW || (unsigned)y >= (unsigned)vH) return; // setPixelColorXY() would ignore it
+      unsigned idx = x + y * vW;
+      if (!masks[idx]) touched.push_back(idx);
+      masks[idx] |= states;
+    };
+    switch (m12) {
+      case M12_pArc:      arcPixels(i, [&](int x, int y) { plot(x, y, 0xFF); }); break;
+      case M12_pCorner:   cornerPixels(i, [&](int x, int y) { plot(x, y, 0xFF); }); break;
+      case M12_sPinwheel: for (unsigned s = 0; s < 8; s++) pinwheelPixels(i, vW, vH, s, [&](int x, int y) { plot(x, y, 1 << s); }); break;
+    }
+    // group pixels by the states in which they are drawn (pinwheel has up to 5 distinct groups per ray, others 1)
+    starts[i] = runs.size();
+    for (size_t n = 0; n < touched.size(); n++) {
+      uint8_t states = masks[touched[n]];
+      if (!states) continue; // already in a group
+      size_t group = runs.size();
+      runs.push_back(states);
+      runs.push_back(0);
+      for (size_t k = n; k < touched.size(); k++) if (masks[touched[k]] == states) {
+        runs.push_back(touched[k]);
+        masks[touched[k]] = 0;
+        runs[group + 1]++;
+      }
+    }
+    int x, y;
+    getMappedPixelXY(m12, i, vW, vH, x, y);
+    reverse[i] = ((unsigned)x < (unsigned)vW && (unsigned)y < (unsigned)vH) ? x + y * vW : 0xFFFF;
+  }
+  starts[vL] = runs.size();
+  if (runs.size() > UINT16_MAX) return; // too large for 16 bit indices (huge segment), calculate on the fly
+
+  size_t size = sizeof(Mapping1D2D) + (2*vL + 1 + runs.size()) * sizeof(uint16_t);
+  _m12map = static_cast<Mapping1D2D*>(allocate_buffer(size, BFRALLOC_PREFER_PSRAM | BFRALLOC_TAG(ALLOC_TAG_SEGMAP)));
+  if (!_m12map) return;
+  _m12map->vWidth  = vW;
+  _m12map->vHeight = vH;
+  _m12map->vLength = vL;
+  _m12map->m12     = m12;
+  _m12map->size    = runs.size();
+  memcpy(_m12map->starts(),  starts.data(),  starts.size()  * sizeof(uint16_t));
+  memcpy(_m12map->reverse(), reverse.data(), reverse.size() * sizeof(uint16_t));
+  memcpy(_m12map->runs(),    runs.data(),    runs.size()    * sizeof(uint16_t));
+  _m12mapFailed = 0;
+  DEBUGFX_PRINTF_P(PSTR("-- 1D->2D map (%d) for %dx%d: %uB\n"), m12, vW, vH, size);
+}
+
+void Segment::freeMapping1D2D() {
+  p_free(_m12map);
+  _m12map = nullptr;
+}
+
+// duplicates expansion map of the segment being copied (transitions)
+void Segment::copyMapping1D2D(const Segment &orig) {
+  if (!orig._m12map) return;
+  _m12map = static_cast<Mapping1D2D*>(allocate_buffer(orig._m12map->bytes(), BFRALLOC_PREFER_PSRAM | BFRALLOC_TAG(ALLOC_TAG_SEGMAP)));
+  if (_m12map) memcpy(_m12map, orig._m12map, orig._m12map->bytes());
+}
 #endif
 
 // 1D strip
@@ -721,6 +1104,19 @@ void IRAM_ATTR_YN Segment::setPixelColor(int i, uint32_t col) const
     const int vW = vWidth();   // segment width in logical pixels (can be 0 if segment is inactive)
     const int vH = vHeight();  // segment height in logical pixels (is always >= 1)
     const auto XY = [&](unsigned x, unsigned y){ return x + y*vW;};
+    if (_m12map && _m12map->isFor(map1D2D, vW, vH)) {
+      // precomputed arc, corner or pinwheel expansion (see updateMapping1D2D())
+      const unsigned state = (map1D2D == M12_sPinwheel) ? getPinwheelState(i, vW, vH) : 0;
+      const uint16_t *run  = _m12map->runs() + _m12map->starts()[i];
+      const uint16_t *end  = _m12map->runs() + _m12map->starts()[i+1];
+      while (run < end) {
+        const unsigned states = *run++;
+        const unsigned count  = *run++;
+        if (states & (1U << state)) for (unsigned k = 0; k < count; k++) setPixelColorRaw(run[k], col);
+        run += count;
+      }
+      return;
+    }
     switch (map1D2D) {
       case M12_Pixels:
         // use all available pixels as a long strip
@@ -732,134 +1128,14 @@ void IRAM_ATTR_YN Segment::setPixelColor(int i, uint32_t col) const
         else for (int x = 0; x < vW; x++) setPixelColorRaw(XY(x, vH - i - 1), col);
         break;
       case M12_pArc:
-        // expand in circular fashion from center
-        if (i == 0)
-          setPixelColorRaw(XY(0, 0), col);
-        else {
-          float r = i;
-          float step = HALF_PI / (2.8284f * r + 4); // we only need (PI/4)/(r/sqrt(2)+1) steps
-          for (float rad = 0.0f; rad <= (HALF_PI/2)+step/2; rad += step) {
-            int x = roundf(sin_t(rad) * r);
-            int y = roundf(cos_t(rad) * r);
-            // exploit symmetry
-            setPixelColorXY(x, y, col);
-            setPixelColorXY(y, x, col);
-          }
-          // Bresenham’s Algorithm (may not fill every pixel)
-          //int d = 3 - (2*i);
-          //int y = i, x = 0;
-          //while (y >= x) {
-          //  setPixelColorXY(x, y, col);
-          //  setPixelColorXY(y, x, col);
-          //  x++;
-          //  if (d > 0) {
-          //    y--;
-          //    d += 4 * (x - y) + 10;
-          //  } else {
-          //    d += 4 * x + 6;
-          //  }
-          //}
-        }
+        arcPixels(i, [&](int x, int y) { setPixelColorXY(x, y, col); });
         break;
       case M12_pCorner:
-        for (int x = 0; x <= i; x++) setPixelColorXY(x, i, col); // note: <= to include i=0. Relies on overflow check in sPC()
-        for (int y = 0; y <  i; y++) setPixelColorXY(i, y, col);
+        cornerPixels(i, [&](int x, int y) { setPixelColorXY(x, y, col); }); // relies on overflow check in sPC()
         break;
-      case M12_sPinwheel: {
-        // Uses Bresenham's algorithm to place coordinates of two lines in arrays then draws between them
-        int startX, startY, cosVal[2], sinVal[2]; // in fixed point scale
-        setPinwheelParameters(i, vW, vH, startX, startY, cosVal, sinVal);
-
-        unsigned maxLineLength = max(vW, vH) + 2; // pixels drawn is always smaller than dx or dy, +1 pair for rounding errors
-        uint16_t lineCoords[2][maxLineLength];    // uint16_t to save ram
-        int lineLength[2] = {0};
-
-        static int prevRays[2] = {INT_MAX, INT_MAX}; // previous two ray numbers
-        int closestEdgeIdx = INT_MAX; // index of the closest edge pixel
-
-        for (int lineNr = 0; lineNr < 2; lineNr++) {
-          int x0 = startX; // x, y coordinates in fixed scale
-          int y0 = startY;
-          int x1 = (startX + (cosVal[lineNr] << 9)); // outside of grid
-          int y1 = (startY + (sinVal[lineNr] << 9)); // outside of grid
-          const int dx =  abs(x1-x0), sx = x0<x1 ? 1 : -1; // x distance & step
-          const int dy = -abs(y1-y0), sy = y0<y1 ? 1 : -1; // y distance & step
-          uint16_t* coordinates = lineCoords[lineNr]; // 1D access is faster
-          int* length = &lineLength[lineNr];          // faster access
-          x0 /= Fixed_Scale; // convert to pixel coordinates
-          y0 /= Fixed_Scale;
-
-          // Bresenham's algorithm
-          int idx = 0;
-          int err = dx + dy;
-          while (true) {
-            if ((unsigned)x0 >= (unsigned)vW || (unsigned)y0 >= (unsigned)vH) {
-              closestEdgeIdx = min(closestEdgeIdx, idx-2);
-              break; // stop if outside of grid (exploit unsigned int overflow)
-            }
-            coordinates[idx++] = x0;
-            coordinates[idx++] = y0;
-            (*length)++;
-            // note: since endpoint is out of grid, no need to check if endpoint is reached
-            int e2 = 2 * err;
-            if (e2 >= dy) { err += dy; x0 += sx; }
-            if (e2 <= dx) { err += dx; y0 += sy; }
-          }
-        }
-
-        // fill up the shorter line with missing coordinates, so block filling works correctly and efficiently
-        int diff = lineLength[0] - lineLength[1];
-        int longLineIdx = (diff > 0) ? 0 : 1;
-        int shortLineIdx = longLineIdx ? 0 : 1;
-        if (diff != 0) {
-          int idx = (lineLength[shortLineIdx] - 1) * 2; // last valid coordinate index
-          int lastX = lineCoords[shortLineIdx][idx++];
-          int lastY = lineCoords[shortLineIdx][idx++];
-          bool keepX = lastX == 0 || lastX == vW - 1;
-          for (int d = 0; d < abs(diff); d++) {
-            lineCoords[shortLineIdx][idx] = keepX ? lastX :lineCoords[longLineIdx][idx];
-            idx++;
-            lineCoords[shortLineIdx][idx] =  keepX ? lineCoords[longLineIdx][idx] : lastY;
-            idx++;
-          }
-        }
-
-        // draw and block-fill the line coordinates. Note: block filling only efficient if angle between lines is small
-        closestEdgeIdx += 2;
-        int max_i = getPinwheelLength(vW, vH) - 1;
-        bool drawFirst = !(prevRays[0] == i - 1 || (i == 0 && prevRays[0] == max_i)); // draw first line if previous ray was not adjacent including wrap
-        bool drawLast  = !(prevRays[0] == i + 1 || (i == max_i && prevRays[0] == 0)); // same as above for last line
-        for (int idx = 0; idx < lineLength[longLineIdx] * 2;) { //!! should be long line idx!
-          int x1 = lineCoords[0][idx];
-          int x2 = lineCoords[1][idx++];
-          int y1 = lineCoords[0][idx];
-          int y2 = lineCoords[1][idx++];
-          int minX, maxX, minY, maxY;
-          (x1 < x2) ? (minX = x1, maxX = x2) : (minX = x2, maxX = x1);
-          (y1 < y2) ? (minY = y1, maxY = y2) : (minY = y2, maxY = y1);
-
-          // fill the block between the two x,y points
-          bool alwaysDraw = (drawFirst && drawLast) || // No adjacent rays, draw all pixels
-                            (idx > closestEdgeIdx)  || // Edge pixels on uneven lines are always drawn
-                            (i == 0 && idx == 2)    || // Center pixel special case
-                            (i == prevRays[1]);        // Effect drawing twice in 1 frame
-          for (int x = minX; x <= maxX; x++) {
-            for (int y = minY; y <= maxY; y++) {
-              bool onLine1 = x == x1 && y == y1;
-              bool onLine2 = x == x2 && y == y2;
-              if ((alwaysDraw) ||
-                  (!onLine1 && (!onLine2 || drawLast))  || // Middle pixels and line2 if drawLast
-                  (!onLine2 && (!onLine1 || drawFirst))    // Middle pixels and line1 if drawFirst
-                ) {
-                setPixelColorXY(x, y, col);
-              }
-            }
-          }
-        }
-        prevRays[1] = prevRays[0];
-        prevRays[0] = i;
+      case M12_sPinwheel:
+        pinwheelPixels(i, vW, vH, getPinwheelState(i, vW, vH), [&](int x, int y) { setPixelColorXY(x, y, col); });
         break;
-      }
     }
     return;
   } else if (Segment::maxHeight != 1 && (width() == 1 || height() == 1)) {
@@ -935,32 +1211,13 @@ uint32_t IRAM_ATTR_YN Segment::getPixelColor(int i) const
         if (vStrip > 0) { x = vStrip - 1; y = vH - i - 1; }
         else            { y = vH - i - 1; };
         break;
-      case M12_pArc:
-        if (i > vW && i > vH) {
-          x = y = sqrt32_bw(i*i/2);
-          break; // use diagonal
-        }
-        // otherwise fallthrough
-      case M12_pCorner:
-        // use longest dimension
-        if (vW > vH) x = i;
-        else         y = i;
-        break;
-      case M12_sPinwheel: {
-        // not 100% accurate, returns pixel at outer edge
-        int cosVal[2], sinVal[2];
-        setPinwheelParameters(i, vW, vH, x, y, cosVal, sinVal, true);
-        int maxX = (vW-1) * Fixed_Scale;
-        int maxY = (vH-1) * Fixed_Scale;
-        // trace ray from center until we hit any edge - to avoid rounding problems, we use fixed point coordinates
-        while ((x < maxX)  && (y < maxY) && (x > Fixed_Scale) && (y > Fixed_Scale)) {
-          x += cosVal[0]; // advance to next position
-          y += sinVal[0];
+      default:
+        if (_m12map && _m12map->isFor(map1D2D, vW, vH)) {
+          const unsigned idx = _m12map->reverse()[i]; // precomputed (see updateMapping1D2D())
+          return idx == 0xFFFF ? 0 : getPixelColorRaw(idx);
         }
-        x /= Fixed_Scale;
-        y /= Fixed_Scale;
+        getMappedPixelXY(map1D2D, i, vW, vH, x, y);
         break;
-      }
     }
     return getPixelColorXY(x, y);
   }
@@ -1130,16 +1387,48 @@ uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool moving, uint
     case 1: blend = LINEARBLEND; break;
     case 2: blend = LINEARBLEND_NOWRAP; break;
   }
+#ifndef WLED_DISABLE_PALETTE_LUT
+  // same result as ColorFromPalette(): every blend type is a lookup into the LINEARBLEND table
+  if (blend == LINEARBLEND_NOWRAP) paletteIndex = (paletteIndex * 0xF0) >> 8;
+  else if (blend == NOBLEND)       paletteIndex &= 0xF0;
+  uint32_t palcol = paletteLookup(paletteIndex);
+  if (pbri < 255) {
+    uint32_t scale = pbri + 1; // same rounding as ColorFromPalette()
+    palcol = ((((palcol & 0x00FF00FF) * scale) >> 8) & 0x00FF00FF) | ((((palcol & 0x0000FF00) * scale) >> 8) & 0x0000FF00);
+  }
+  return palcol | (color & 0xFF000000);
+#else
   CRGBW palcol = ColorFromPalette(_currentPalette, paletteIndex, pbri, blend);
   palcol.w = W(color);
 
   return palcol.color32;
+#endif
+}
+
+#ifndef WLED_DISABLE_PALETTE_LUT
+// the table is filled lazily so effects using only a few palette colors do not pay for all 256 entries
+uint32_t Segment::paletteLookup(uint8_t index) const {
+  if (!_paletteLUT && !_paletteLUTFailed) {
+    _paletteLUT = static_cast<uint32_t*>(allocate_buffer(256 * sizeof(uint32_t), BFRALLOC_PREFER_DRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR | BFRALLOC_TAG(ALLOC_TAG_PALETTE)));
+    _paletteLUTFailed = !_paletteLUT;
+  }
+  if (!_paletteLUT) return ColorFromPalette(_currentPalette, index, 255, LINEARBLEND);
+  uint32_t c = _paletteLUT[index];
+  if (!c) {
+    c = ColorFromPalette(_currentPalette, index, 255, LINEARBLEND) | 0xFF000000; // W byte marks entry as filled
+    _paletteLUT[index] = c;
+  }
+  return c & 0x00FFFFFF;
 }
+#endif
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // WS2812FX class implementation
 ///////////////////////////////////////////////////////////////////////////////
+WLED_RENDER_LOCAL unsigned long WS2812FX::now = 0;
+WLED_RENDER_LOCAL Segment *WS2812FX::_currentSegment = nullptr;
+WLED_RENDER_LOCAL uint8_t  WS2812FX::_segment_index  = 0;
 
 //do not call this method from system context (network callback)
 void WS2812FX::finalizeInit() {
@@ -1220,70 +1509,185 @@ void WS2812FX::finalizeInit() {
 
   // allocate frame buffer after matrix has been set up (gaps!)
   p_free(_pixels); // using realloc on large buffers can cause additional fragmentation instead of reducing it
+  p_free(_pixelCCT); // CCT plane is reallocated on demand in show()
+  _pixelCCT = nullptr;
+  _frameValid = false;
   // use PSRAM if available: there is no measurable perfomance impact between PSRAM and DRAM on S2/S3 with QSPI PSRAM for this buffer
-  _pixels = static_cast<uint32_t*>(allocate_buffer(getLengthTotal() * sizeof(uint32_t), BFRALLOC_ENFORCE_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR));
+  _pixels = static_cast<uint32_t*>(allocate_buffer(getLengthTotal() * sizeof(uint32_t), BFRALLOC_ENFORCE_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR | BFRALLOC_TAG(ALLOC_TAG_FRAME)));
+  #ifdef WLED_ENABLE_PIPELINED_OUTPUT
+  // second frame buffer for output task, without it frames are shown directly
+  p_free(_outPixels);
+  p_free(_outPixelCCT);
+  _outPixelCCT = nullptr;
+  _outputPending = false;
+  _outPixels = static_cast<uint32_t*>(allocate_buffer(getLengthTotal() * sizeof(uint32_t), BFRALLOC_ENFORCE_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_TAG(ALLOC_TAG_FRAME)));
+  if (!_outputTask && _outPixels) {
+    _outputStart = xSemaphoreCreateBinary();
+    _outputDone  = xSemaphoreCreateBinary();
+    // loop() runs on core 1, output is sent from core 0
+    if (_outputStart && _outputDone) xTaskCreatePinnedToCore(outputTask, "LED_OUT", 4096, this, 1, &_outputTask, 0);
+    if (!_outputTask) DEBUG_PRINTLN(F("Error: Failed to create output task."));
+  }
+  #endif
+  #ifdef WLED_ENABLE_PARALLEL_RENDER
+  for (render_task_t &task : _renderTasks) {
+    if (task.handle) continue;
+    task.strip = this;
+    task.start = xSemaphoreCreateBinary();
+    task.done  = xSemaphoreCreateBinary();
+    // loop() runs on core 1, render tasks on core 0 (same stack size as loop() as they run the same effect code)
+    if (task.start && task.done) xTaskCreatePinnedToCore(renderTask, "LED_FX", 8192, &task, 1, &task.handle, 0);
+    if (!task.handle) { DEBUG_PRINTLN(F("Error: Failed to create render task.")); break; }
+  }
+  #endif
   DEBUG_PRINTF_P(PSTR("strip buffer size: %uB\n"), getLengthTotal() * sizeof(uint32_t));
   DEBUG_PRINTF_P(PSTR("Heap after strip init: %uB\n"), getFreeHeapSize());
 }
 
+// runs effect function of a due segment, _segment_index must be set to the segment's index
+void WS2812FX::renderSegment(Segment &seg, unsigned long nowUp) {
+  unsigned frameDelay = FRAMETIME;
+
+  if (!seg.freeze) { //only run effect function if not frozen
+    // Effect blending
+    uint16_t prog = seg.progress();
+    seg.beginDraw(prog);                // set up parameters for get/setPixelColor() (will also blend colors and palette if blend style is FADE)
+    _currentSegment = &seg;             // set current segment for effect functions (SEGMENT & SEGENV)
+    seg.loadRandom();                   // swap in segment's random stream (no-op unless WLED_ENABLE_DETERMINISTIC_RNG)
+    unsigned long t0 = micros();
+    // workaround for on/off transition to respect blending style
+    frameDelay = (*_mode[seg.mode])();  // run new/current mode (needed for bri workaround)
+    _segmentTiming[_segment_index].fx.add(micros() - t0);
+    seg.saveRandom();
+    seg.call++;
+    // if segment is in transition and no old segment exists we don't need to run the old mode
+    // (blendSegments() takes care of On/Off transitions and clipping)
+    Segment *segO = seg.getOldSegment();
+    if (segO && isOldModeRunning(seg, *segO)) {
+      segO->modeBlend(true);            // set semaphore for beginDraw() to blend colors and palette
+      segO->beginDraw(prog);            // set up palette & colors (also sets draw dimensions), parent segment has transition progress
+      _currentSegment = segO;           // set current segment
+      segO->loadRandom();
+      t0 = micros();
+      // workaround for on/off transition to respect blending style
+      frameDelay = min(frameDelay, (unsigned)(*_mode[segO->mode])());  // run old mode (needed for bri workaround; semaphore!!)
+      _segmentTiming[_segment_index].old.add(micros() - t0);
+      segO->saveRandom();
+      segO->call++;                     // increment old mode run counter
+      segO->modeBlend(false);           // unset semaphore
+    }
+    if (seg.isInTransition() && frameDelay > FRAMETIME) frameDelay = FRAMETIME; // force faster updates during transition
+  }
+
+  seg.next_time = nowUp + frameDelay;
+}
+
+#ifdef WLED_ENABLE_PARALLEL_RENDER
+void WS2812FX::renderTask(void *param) {
+  render_task_t *task = static_cast<render_task_t*>(param);
+  for (;;) {
+    if (xSemaphoreTake(task->start, portMAX_DELAY) != pdTRUE) continue;
+    task->strip->renderQueued();
+    xSemaphoreGive(task->done);
+  }
+}
+
+// renders queued segments until the queue is empty (called by loop() and render tasks at the same time)
+void WS2812FX::renderQueued() {
+  now = _renderNow + timebase;
+  for (unsigned i = _renderNext++; i < _renderCount; i = _renderNext++) {
+    _segment_index = _renderQueue[i];
+    renderSegment(_segments[_segment_index], _renderNow);
+    #ifdef WLED_ENABLE_DETERMINISTIC_RNG
+    if (i == _renderCount - 1U) { _renderRndState = hwRndState; _renderRnd16State = rand16seed; }
+    #endif
+  }
+}
+
+// segments only draw into their own buffers and draw context so they can be rendered in any order
+// (effects reading other segments, like Copy Segment, may see them half drawn)
+void WS2812FX::renderParallel(unsigned long nowUp) {
+  _renderNow  = nowUp;
+  _renderNext = 0;
+  unsigned started = 0;
+  for (render_task_t &task : _renderTasks) {
+    if (started + 1 >= _renderCount || !task.handle) break; // loop() renders one segment itself
+    xSemaphoreGive(task.start);
+    started++;
+  }
+  const uint8_t index = _segment_index;
+  renderQueued();
+  for (unsigned i = 0; i < started; i++) xSemaphoreTake(_renderTasks[i].done, portMAX_DELAY);
+  _segment_index = index;
+  #ifdef WLED_ENABLE_DETERMINISTIC_RNG
+  // random palette is generated from the stream the last segment left behind, same as with serial rendering
+  hwRndState = _renderRndState;
+  rand16seed = _renderRnd16State;
+  #endif
+}
+#endif
+
 void WS2812FX::service() {
+  unsigned long nowUs = micros();
   unsigned long nowUp = millis(); // Be aware, millis() rolls over every 49 days
   now = nowUp + timebase;
-  unsigned long elapsed = nowUp - _lastServiceShow;
-  if (_suspend || elapsed <= MIN_FRAME_DELAY) return;   // keep wifi alive - no matter if triggered or unlimited
-  if (!_triggered && (_targetFps != FPS_UNLIMITED)) {   // unlimited mode = no frametime
-    if (elapsed < _frametime) return;                   // too early for service
+  if (_suspend || nowUs - _lastServiceShow < MIN_FRAME_DELAY * 1000UL) return; // keep wifi alive - no matter if triggered or unlimited
+  // frames are planned against a deadline in us (frame rate is not quantised to whole ms)
+  // if service() is late by a frame or more the missed deadlines are dropped, so the cadence is kept
+  if (_targetFps != FPS_UNLIMITED) {                    // unlimited mode = no frametime
+    long late = (long)(nowUs - _nextFrameUs);
+    if (late < 0) {
+      if (!_triggered) return;                          // too early for service
+    } else {
+      if (late > 1000000L) { _nextFrameUs = nowUs; late = 0; } // first frame or resumed after a long pause: restart cadence
+      unsigned missed = late / _frameTimeUs;
+      _nextFrameUs += (missed + 1) * _frameTimeUs;
+      _frameStats.deadline(late, missed);
+    }
   }
 
   bool doShow = false;
 
   _isServicing = true;
+  #ifdef WLED_ENABLE_PIPELINED_OUTPUT
+  if (_outputPending) startOutput(); // send previous frame while effects render the next one
+  #endif
   _segment_index = 0;
+  if (_segmentTiming.size() != _segments.size()) _segmentTiming.resize(_segments.size());
+  #ifdef WLED_ENABLE_PARALLEL_RENDER
+  _renderCount = 0;
+  #endif
 
   for (Segment &seg : _segments) {
     if (_suspend) break; // immediately stop processing segments if suspend requested during service()
 
     // process transition (also pre-calculates progress value)
     seg.handleTransition();
+    seg.detachOldSegment(); // effect (or reset) is about to change segment's buffers
     // reset the segment runtime data if needed
     seg.resetIfRequired();
 
     if (!seg.isActive()) continue;
+    #ifdef WLED_ENABLE_DETERMINISTIC_RNG
+    if (seg.call == 0) seg.seedRandom(hashInt(_rngSeed + _segment_index)); // (re)start the segment's random stream with the effect
+    #endif
 
+    // segments due within half a frame are updated now (aligns effect updates to the frame cadence)
     // last condition ensures all solid segments are updated at the same time
-    if (nowUp > seg.next_time || _triggered || (doShow && seg.mode == FX_MODE_STATIC))
+    if ((long)(nowUp + _frameTimeUs / 2000 - seg.next_time) >= 0 || _triggered || (doShow && seg.mode == FX_MODE_STATIC))
     {
       doShow = true;
-      unsigned frameDelay = FRAMETIME;
-
-      if (!seg.freeze) { //only run effect function if not frozen
-        // Effect blending
-        uint16_t prog = seg.progress();
-        seg.beginDraw(prog);                // set up parameters for get/setPixelColor() (will also blend colors and palette if blend style is FADE)
-        _currentSegment = &seg;             // set current segment for effect functions (SEGMENT & SEGENV)
-        // workaround for on/off transition to respect blending style
-        frameDelay = (*_mode[seg.mode])();  // run new/current mode (needed for bri workaround)
-        seg.call++;
-        // if segment is in transition and no old segment exists we don't need to run the old mode
-        // (blendSegments() takes care of On/Off transitions and clipping)
-        Segment *segO = seg.getOldSegment();
-        if (segO && segO->isActive() && (seg.mode != segO->mode || blendingStyle != BLEND_STYLE_FADE ||
-            (segO->name != seg.name && segO->name && seg.name && strncmp(segO->name, seg.name, WLED_MAX_SEGNAME_LEN) != 0))) {
-          Segment::modeBlend(true);         // set semaphore for beginDraw() to blend colors and palette
-          segO->beginDraw(prog);            // set up palette & colors (also sets draw dimensions), parent segment has transition progress
-          _currentSegment = segO;           // set current segment
-          // workaround for on/off transition to respect blending style
-          frameDelay = min(frameDelay, (unsigned)(*_mode[segO->mode])());  // run old mode (needed for bri workaround; semaphore!!)
-          segO->call++;                     // increment old mode run counter
-          Segment::modeBlend(false);        // unset semaphore
-        }
-        if (seg.isInTransition() && frameDelay > FRAMETIME) frameDelay = FRAMETIME; // force faster updates during transition
-      }
-
-      seg.next_time = nowUp + frameDelay;
+      #ifdef WLED_ENABLE_PARALLEL_RENDER
+      if (_renderTasks[0].handle) _renderQueue[_renderCount++] = _segment_index; // rendered concurrently below
+      else
+      #endif
+      renderSegment(seg, nowUp);
     }
     _segment_index++;
   }
+  #ifdef WLED_ENABLE_PARALLEL_RENDER
+  if (_renderCount) renderParallel(nowUp);
+  #endif
 
   #ifdef WLED_DEBUG
   if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _frametime)) DEBUG_PRINTF_P(PSTR("Slow effects %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_frametime);
@@ -1291,32 +1695,37 @@ void WS2812FX::service() {
   if (doShow && !_suspend) {
     yield();
     Segment::handleRandomPalette(); // slowly transition random palette; move it into for loop when each segment has individual random palette
-    _lastServiceShow = nowUp; // update timestamp, for precise FPS control
-    show();
+    _lastServiceShow = nowUs; // update timestamp, for precise FPS control
+    _frameStats.frame(nowUs);
+    #ifdef WLED_ENABLE_PIPELINED_OUTPUT
+    if (hasFrameChanged(nowUp) && !queueFrame()) show(); // skip compositing and LED update if no segment changed
+    #else
+    if (hasFrameChanged(nowUp)) show(); // skip compositing and LED update if no segment changed
+    #endif
   }
+  #ifdef WLED_ENABLE_PIPELINED_OUTPUT
+  waitForOutput(); // buses are only used by output task while service() runs
+  #endif
   #ifdef WLED_DEBUG
   if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _frametime)) DEBUG_PRINTF_P(PSTR("Slow strip %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_frametime);
   #endif
 
   _triggered = false;
   _isServicing = false;
+  if (!_idle && isFrameStatic()) {
+    _idle = true;
+    _idleSince = millis();
+  }
 }
 
 // https://en.wikipedia.org/wiki/Blend_modes but using a for top layer & b for bottom layer
-static uint8_t _top       (uint8_t a, uint8_t b) { return a; }
-static uint8_t _bottom    (uint8_t a, uint8_t b) { return b; }
-static uint8_t _add       (uint8_t a, uint8_t b) { unsigned t = a + b; return t > 255 ? 255 : t; }
-static uint8_t _subtract  (uint8_t a, uint8_t b) { return b > a ? (b - a) : 0; }
-static uint8_t _difference(uint8_t a, uint8_t b) { return b > a ? (b - a) : (a - b); }
-static uint8_t _average   (uint8_t a, uint8_t b) { return (a + b) >> 1; }
+// (per channel functions for modes that need multiplication or division, simple modes are implemented in pairs below)
 #if defined(ESP8266) || defined(CONFIG_IDF_TARGET_ESP32C3)
 static uint8_t _multiply  (uint8_t a, uint8_t b) { return ((a * b) + 255) >> 8; } // faster than division on C3 but slightly less accurate
 #else
 static uint8_t _multiply  (uint8_t a, uint8_t b) { return (a * b) / 255; } // origianl uses a & b in range [0,1]
 #endif
 static uint8_t _divide    (uint8_t a, uint8_t b) { return a > b ? (b * 255) / a : 255; }
-static uint8_t _lighten   (uint8_t a, uint8_t b) { return a > b ? a : b; }
-static uint8_t _darken    (uint8_t a, uint8_t b) { return a < b ? a : b; }
 static uint8_t _screen    (uint8_t a, uint8_t b) { return 255 - _multiply(~a,~b); } // 255 - (255-a)*(255-b)/255
 static uint8_t _overlay   (uint8_t a, uint8_t b) { return b < 128 ? 2 * _multiply(a,b) : (255 - 2 * _multiply(~a,~b)); }
 static uint8_t _hardlight (uint8_t a, uint8_t b) { return a < 128 ? 2 * _multiply(a,b) : (255 - 2 * _multiply(~a,~b)); }
@@ -1328,19 +1737,52 @@ static uint8_t _softlight (uint8_t a, uint8_t b) { return (b * b * (255 - 2 * a)
 static uint8_t _dodge     (uint8_t a, uint8_t b) { return _divide(~a,b); }
 static uint8_t _burn      (uint8_t a, uint8_t b) { return ~_divide(a,~b); }
 
-void WS2812FX::blendSegment(const Segment &topSegment) const {
+// whole pixel blend kernels (top, bottom), see blendSegment()
+// simple modes process R & B and W & G channel pairs in parallel (same poorman's SIMD as color_blend() in colors.cpp)
+// modes that need per channel multiplication or division use the channel functions above
+typedef uint32_t(*PixelBlendFunc)(uint32_t, uint32_t);
+constexpr uint32_t TWO_CHANNEL_MASK  = 0x00FF00FF;
+constexpr uint32_t TWO_CHANNEL_CARRY = 0x01000100;
+static inline uint32_t _carryMask(uint32_t t)               { t &= TWO_CHANNEL_CARRY; return t - (t >> 8); } // 0xFF in each channel with carry bit set
+static inline uint32_t _addPair  (uint32_t a, uint32_t b)   { uint32_t t = a + b; return (t | _carryMask(t)) & TWO_CHANNEL_MASK; } // saturated a + b
+static inline uint32_t _subPair  (uint32_t a, uint32_t b)   { uint32_t t = (b | TWO_CHANNEL_CARRY) - a; return t & _carryMask(t); } // b - a or 0 if a > b
+static inline uint32_t _diffPair (uint32_t a, uint32_t b)   { return _subPair(a, b) | _subPair(b, a); }
+static inline uint32_t _avgPair  (uint32_t a, uint32_t b)   { return ((a + b) >> 1) & TWO_CHANNEL_MASK; }
+static inline uint32_t _maxPair  (uint32_t a, uint32_t b)   { uint32_t m = _carryMask((a | TWO_CHANNEL_CARRY) - b); return (a & m) | (b & ~m & TWO_CHANNEL_MASK); } // m: a >= b
+static inline uint32_t _minPair  (uint32_t a, uint32_t b)   { uint32_t m = _carryMask((a | TWO_CHANNEL_CARRY) - b); return (b & m) | (a & ~m & TWO_CHANNEL_MASK); }
+template<uint32_t(*Op)(uint32_t, uint32_t)>
+static inline uint32_t _pairs    (uint32_t a, uint32_t b)   { return Op(a & TWO_CHANNEL_MASK, b & TWO_CHANNEL_MASK) | (Op((a >> 8) & TWO_CHANNEL_MASK, (b >> 8) & TWO_CHANNEL_MASK) << 8); }
+template<uint8_t(*Op)(uint8_t, uint8_t)>
+static inline uint32_t _channels (uint32_t a, uint32_t b)   { return RGBW32(Op(R(a),R(b)), Op(G(a),G(b)), Op(B(a),B(b)), Op(W(a),W(b))); }
+static inline uint32_t _topPixel   (uint32_t a, uint32_t b) { return a; }
+static inline uint32_t _bottomPixel(uint32_t a, uint32_t b) { return b; }
+
+// blends (opaque or with constant opacity) a row of top pixels into bottom pixels, one instance per blend mode
+template<PixelBlendFunc Blend>
+static void _blendRow(uint32_t *bottom, const uint32_t *top, size_t len, uint8_t opacity) {
+  if (opacity == 255) for (size_t i = 0; i < len; i++) bottom[i] = Blend(top[i], bottom[i]);
+  else                for (size_t i = 0; i < len; i++) bottom[i] = color_blend(bottom[i], Blend(top[i], bottom[i]), opacity);
+}
+
+// indexed by segment's blendMode: top, bottom, add, subtract, difference, average, multiply, divide, lighten, darken, screen, overlay, hardlight, softlight, dodge, burn
+static const PixelBlendFunc pixelBlendFuncs[] = {
+  _topPixel, _bottomPixel,
+  _pairs<_addPair>, _pairs<_subPair>, _pairs<_diffPair>, _pairs<_avgPair>,
+  _channels<_multiply>, _channels<_divide>, _pairs<_maxPair>, _pairs<_minPair>, _channels<_screen>, _channels<_overlay>,
+  _channels<_hardlight>, _channels<_softlight>, _channels<_dodge>, _channels<_burn>
+};
+typedef void(*RowBlendFunc)(uint32_t*, const uint32_t*, size_t, uint8_t);
+static const RowBlendFunc rowBlendFuncs[] = {
+  _blendRow<_topPixel>, _blendRow<_bottomPixel>,
+  _blendRow<_pairs<_addPair>>, _blendRow<_pairs<_subPair>>, _blendRow<_pairs<_diffPair>>, _blendRow<_pairs<_avgPair>>,
+  _blendRow<_channels<_multiply>>, _blendRow<_channels<_divide>>, _blendRow<_pairs<_maxPair>>, _blendRow<_pairs<_minPair>>, _blendRow<_channels<_screen>>, _blendRow<_channels<_overlay>>,
+  _blendRow<_channels<_hardlight>>, _blendRow<_channels<_softlight>>, _blendRow<_channels<_dodge>>, _blendRow<_channels<_burn>>
+};
 
-  typedef uint8_t(*FuncType)(uint8_t, uint8_t);
-  FuncType funcs[] = {
-    _top, _bottom,
-    _add, _subtract, _difference, _average,
-    _multiply, _divide, _lighten, _darken, _screen, _overlay,
-    _hardlight, _softlight, _dodge, _burn
-  };
+void WS2812FX::blendSegment(const Segment &topSegment, uint8_t *pixelCCT) const {
 
-  const size_t blendMode = topSegment.blendMode < (sizeof(funcs) / sizeof(FuncType)) ? topSegment.blendMode : 0;
-  const auto func  = funcs[blendMode]; // blendMode % (sizeof(funcs) / sizeof(FuncType))
-  const auto blend = [&](uint32_t top, uint32_t bottom){ return RGBW32(func(R(top),R(bottom)), func(G(top),G(bottom)), func(B(top),B(bottom)), func(W(top),W(bottom))); };
+  const size_t blendMode = topSegment.blendMode < (sizeof(pixelBlendFuncs) / sizeof(PixelBlendFunc)) ? topSegment.blendMode : 0;
+  const auto   blend     = pixelBlendFuncs[blendMode]; // whole pixel blend function (top, bottom)
 
   const int     length     = topSegment.length();     // physical segment length (counts all pixels in 2D segment)
   const int     width      = topSegment.width();
@@ -1356,6 +1798,31 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
 
   Segment::setClippingRect(0, 0);             // disable clipping by default
 
+  // fast path for the most common case: no transition, no mirroring/reversing and no grouping/spacing
+  // segment's pixels map 1:1 onto frame buffer rows so they can be blended row by row with a per blend mode kernel
+  // or just copied if segment is opaque and uses "top" blend mode
+  // (On/Off workaround below only blacks out segment if global brightness goes to 0 using a non-fade style)
+  if (!topSegment.isInTransition() && (blendingStyle == BLEND_STYLE_FADE || bri || !briT) && topSegment.groupLength() == 1
+    && !topSegment.reverse && !topSegment.mirror && !topSegment.reverse_y && !topSegment.mirror_y && !topSegment.transpose) {
+    const RowBlendFunc blendPixels = rowBlendFuncs[blendMode];
+    const auto blendRow = [&](size_t indx, const uint32_t *src, size_t len) {
+      if (opacity == 255 && blendMode == 0) memcpy(_pixels + indx, src, len * sizeof(uint32_t));
+      else blendPixels(_pixels + indx, src, len, opacity);
+      if (pixelCCT) memset(pixelCCT + indx, cct, len);
+    };
+    if (isMatrix && stopIndx <= matrixSize) {
+#ifndef WLED_DISABLE_2D
+      for (int y = 0; y < height; y++) blendRow(XY(topSegment.start, topSegment.startY + y), topSegment.pixels + y * width, width);
+      return;
+#endif
+    } else if (topSegment.offset < length) {
+      const int ofs = topSegment.offset; // offset/phase: segment's pixels wrap around
+      blendRow(topSegment.start + ofs, topSegment.pixels, length - ofs);
+      if (ofs) blendRow(topSegment.start, topSegment.pixels + length - ofs, ofs);
+      return;
+    }
+  }
+
   const unsigned dw = (blendingStyle==BLEND_STYLE_OUTSIDE_IN ? progInv : progress) * width / 0xFFFFU + 1;
   const unsigned dh = (blendingStyle==BLEND_STYLE_OUTSIDE_IN ? progInv : progress) * height / 0xFFFFU + 1;
   const unsigned orgBS = blendingStyle;
@@ -1425,7 +1892,7 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
       const int baseY = topSegment.startY + y;
       size_t indx = XY(baseX, baseY); // absolute address on strip
       _pixels[indx] = color_blend(_pixels[indx], blend(c, _pixels[indx]), o);
-      if (_pixelCCT) _pixelCCT[indx] = cct;
+      if (pixelCCT) pixelCCT[indx] = cct;
       // Apply mirroring
       if (topSegment.mirror || topSegment.mirror_y) {
         const int mirrorX = topSegment.start  + width  - x - 1;
@@ -1436,10 +1903,10 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         if (topSegment.mirror)                        _pixels[idxMX] = color_blend(_pixels[idxMX], blend(c, _pixels[idxMX]), o);
         if (topSegment.mirror_y)                      _pixels[idxMY] = color_blend(_pixels[idxMY], blend(c, _pixels[idxMY]), o);
         if (topSegment.mirror && topSegment.mirror_y) _pixels[idxMM] = color_blend(_pixels[idxMM], blend(c, _pixels[idxMM]), o);
-        if (_pixelCCT) {
-          if (topSegment.mirror)                        _pixelCCT[idxMX] = cct;
-          if (topSegment.mirror_y)                      _pixelCCT[idxMY] = cct;
-          if (topSegment.mirror && topSegment.mirror_y) _pixelCCT[idxMM] = cct;
+        if (pixelCCT) {
+          if (topSegment.mirror)                        pixelCCT[idxMX] = cct;
+          if (topSegment.mirror_y)                      pixelCCT[idxMY] = cct;
+          if (topSegment.mirror && topSegment.mirror_y) pixelCCT[idxMM] = cct;
         }
       }
     };
@@ -1514,12 +1981,12 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         indxM += topSegment.offset; // offset/phase
         if (indxM >= topSegment.stop) indxM -= length; // wrap
         _pixels[indxM] = color_blend(_pixels[indxM], blend(c, _pixels[indxM]), o);
-        if (_pixelCCT) _pixelCCT[indxM] = cct;
+        if (pixelCCT) pixelCCT[indxM] = cct;
       }
       indx += topSegment.offset; // offset/phase
       if (indx >= topSegment.stop) indx -= length; // wrap
       _pixels[indx] = color_blend(_pixels[indx], blend(c, _pixels[indx]), o);
-      if (_pixelCCT) _pixelCCT[indx] = cct;
+      if (pixelCCT) pixelCCT[indx] = cct;
     };
 
     // if we blend using "push" style we need to "shift" canvas to left/right/
@@ -1568,64 +2035,248 @@ void WS2812FX::show() {
     errorFlag = ERR_NORAM;
     return; // no pixels allocated, nothing to show
   }
+  #ifdef WLED_ENABLE_PIPELINED_OUTPUT
+  _outputPending = false; // this frame is newer than the one waiting for output (output task is idle outside service())
+  #endif
 
   unsigned long showNow = millis();
+  const int cct = composeFrame();
+  paintFrame(_pixels, cct == CCT_PER_PIXEL ? _pixelCCT : nullptr, cct);
+  updateFps(showNow);
+}
+
+void WS2812FX::updateFps(unsigned long showNow) {
   size_t diff = showNow - _lastShow;
+  if (diff > 0) { // skip calculation if no time has passed
+    size_t fpsCurr = (1000 << FPS_CALC_SHIFT) / diff; // fixed point math
+    _cumulativeFps = (FPS_CALC_AVG * _cumulativeFps + fpsCurr + FPS_CALC_AVG / 2) / (FPS_CALC_AVG + 1);   // "+FPS_CALC_AVG/2" for proper rounding
+    _lastShow = showNow;
+  }
+}
 
+// blends all segments into frame buffer (unless in realtime mode) and runs show callback
+// returns CCT to use for the frame: -1 if CCT is not used, CCT_PER_PIXEL if _pixelCCT holds CCT of each pixel
+int WS2812FX::composeFrame() {
   size_t totalLen = getLengthTotal();
+  const bool blendSegments = realtimeMode == REALTIME_MODE_INACTIVE || useMainSegmentOnly || realtimeOverride > REALTIME_OVERRIDE_NONE;
   // WARNING: as WLED doesn't handle CCT on pixel level but on Segment level instead
   // we need to keep track of each pixel's CCT when blending segments (if CCT is present)
   // and then set appropriate CCT from that pixel during paint (see below).
-  if ((hasCCTBus() || correctWB) && !cctFromRgb)
-    _pixelCCT = static_cast<uint8_t*>(allocate_buffer(totalLen * sizeof(uint8_t), BFRALLOC_PREFER_PSRAM)); // allocate CCT buffer if necessary, prefer PSRAM
-  if (_pixelCCT) memset(_pixelCCT, 127, totalLen); // set neutral (50:50) CCT
-
-  if (realtimeMode == REALTIME_MODE_INACTIVE || useMainSegmentOnly || realtimeOverride > REALTIME_OVERRIDE_NONE) {
+  // If all blended segments use the same CCT the frame is uniform and CCT is set only once.
+  const bool useCCT = (hasCCTBus() || correctWB) && !cctFromRgb;
+  uint8_t frameCCT = 127;   // neutral (50:50) CCT, also used if no segment is blended
+  bool    cctPerPixel = false;
+  if (useCCT && blendSegments) {
+    bool first = true;
+    for (const Segment &seg : _segments) {
+      if (!seg.isActive() || !(seg.on || seg.isInTransition())) continue;
+      const uint8_t segCCT = seg.currentCCT();
+      if (first) frameCCT = segCCT;
+      else if (segCCT != frameCCT) cctPerPixel = true;
+      first = false;
+    }
+    // pixels not covered by any segment are black (CCT does not matter) unless callback paints them
+    if (_callback && frameCCT != 127) cctPerPixel = true;
+  }
+  if (cctPerPixel && !_pixelCCT) {
+    // CCT plane is kept until strip is reinitialised (or CCT is no longer used)
+    _pixelCCT = static_cast<uint8_t*>(allocate_buffer(totalLen * sizeof(uint8_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_TAG(ALLOC_TAG_CCT))); // prefer PSRAM
+    if (_pixelCCT) memset(_pixelCCT, 127, totalLen); // set neutral (50:50) CCT
+    _pixelCCTDirty = false;
+  } else if (!useCCT && _pixelCCT) {
+    p_free(_pixelCCT);
+    _pixelCCT = nullptr;
+  }
+  if (!_pixelCCT) cctPerPixel = false; // out of memory: use CCT of the first segment for all pixels
+  if (cctPerPixel && _pixelCCTDirty) {
+    memset(_pixelCCT, 127, totalLen); // previous frame left non-neutral CCT values
+    _pixelCCTDirty = false;
+  }
+
+  unsigned blended = 0;
+  if (blendSegments) {
     // clear frame buffer
     for (size_t i = 0; i < totalLen; i++) _pixels[i] = BLACK; // memset(_pixels, 0, sizeof(uint32_t) * getLengthTotal());
     // blend all segments into (cleared) buffer
-    for (Segment &seg : _segments) if (seg.isActive() && (seg.on || seg.isInTransition())) {
-      blendSegment(seg);              // blend segment's buffer into frame buffer
+    for (size_t s = 0; s < _segments.size(); s++) {
+      const Segment &seg = _segments[s];
+      if (!seg.isActive() || !(seg.on || seg.isInTransition())) continue;
+      // CCT plane only needs updating for non-neutral segments or neutral segments covering non-neutral ones
+      uint8_t *pixelCCT = nullptr;
+      if (cctPerPixel && (_pixelCCTDirty || seg.currentCCT() != 127)) {
+        pixelCCT = _pixelCCT;
+        _pixelCCTDirty = true;
+      }
+      unsigned long t0 = micros();
+      blendSegment(seg, pixelCCT);    // blend segment's buffer into frame buffer
+      if (s < _segmentTiming.size()) _segmentTiming[s].blend.add(micros() - t0);
+      seg._dirty = false;
+      blended++;
     }
   }
+  _blendedSegments = blended;
+  _frameValid = blendSegments; // frame buffer in realtime mode is not composited from segments
 
   // avoid race condition, capture _callback value
   show_callback callback = _callback;
   if (callback) callback(); // will call setPixelColor or setRealtimePixelColor
 
+  if (!useCCT) return -1;
+  return cctPerPixel ? CCT_PER_PIXEL : frameCCT;
+}
+
+// sends pixels to buses and LEDs, pixelCCT is only used if cct is CCT_PER_PIXEL
+void WS2812FX::paintFrame(const uint32_t *pixels, const uint8_t *pixelCCT, int cct) {
+  const size_t totalLen = getLengthTotal();
+  const bool cctPerPixel = cct == CCT_PER_PIXEL;
   // paint actual pixels
+  unsigned long t0 = micros();
   int oldCCT = Bus::getCCT(); // store original CCT value (since it is global)
   // when cctFromRgb is true we implicitly calculate WW and CW from RGB values (cct==-1)
   if (cctFromRgb) BusManager::setSegmentCCT(-1);
-  for (size_t i = 0; i < totalLen; i++) {
-    // when correctWB is true setSegmentCCT() will convert CCT into K with which we can then
-    // correct/adjust RGB value according to desired CCT value, it will still affect actual WW/CW ratio
-    if (_pixelCCT) { // cctFromRgb already exluded at allocation
-      if (i == 0 || _pixelCCT[i-1] != _pixelCCT[i]) BusManager::setSegmentCCT(_pixelCCT[i], correctWB);
-    }
-
-    uint32_t c = _pixels[i]; // need a copy, do not modify _pixels directly (no byte access allowed on ESP32)
-    if(c > 0 && !(realtimeMode && arlsDisableGammaCorrection))
+  // when correctWB is true setSegmentCCT() will convert CCT into K with which we can then
+  // correct/adjust RGB value according to desired CCT value, it will still affect actual WW/CW ratio
+  else if (cct >= 0 && !cctPerPixel) BusManager::setSegmentCCT(cct, correctWB);
+  // pixels are handed to buses in runs (chunks of pixels with the same CCT)
+  // if ledmap is used, runs are further split into consecutive physical pixels (ascending or descending, e.g. serpentine rows)
+  constexpr size_t PAINT_RUN_LEN = 64;
+  uint32_t run[PAINT_RUN_LEN];
+  const bool useGamma = !(realtimeMode && arlsDisableGammaCorrection);
+  const bool useMap   = customMappingSize > 0 && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps); // see getMappedPixelIndex()
+  for (size_t i = 0; i < totalLen; ) {
+    if (cctPerPixel && (i == 0 || pixelCCT[i-1] != pixelCCT[i])) BusManager::setSegmentCCT(pixelCCT[i], correctWB); // cctFromRgb already exluded
+    size_t n = 0;
+    do {
+      uint32_t c = pixels[i + n]; // need a copy, do not modify pixels directly (no byte access allowed on ESP32)
+      if (c > 0 && useGamma)
         c = gamma32(c); // apply gamma correction if enabled note: applying gamma after brightness has too much color loss
-    BusManager::setPixelColor(getMappedPixelIndex(i), c);
+      run[n++] = c;
+    } while (n < PAINT_RUN_LEN && i + n < totalLen && !(cctPerPixel && pixelCCT[i+n-1] != pixelCCT[i+n]));
+
+    if (!useMap) BusManager::setPixels(i, run, n);
+    else for (size_t k = 0; k < n; ) {
+      const unsigned first = getMappedPixelIndex(i + k);
+      unsigned last = first;
+      int      dir  = 0;
+      size_t   m    = 1;
+      for (; k + m < n; m++) {
+        const int step = (int)getMappedPixelIndex(i + k + m) - (int)last;
+        if ((step != 1 && step != -1) || (dir && step != dir)) break;
+        dir   = step;
+        last += step;
+      }
+      if (dir < 0) std::reverse(run + k, run + k + m);
+      BusManager::setPixels(dir < 0 ? last : first, run + k, m);
+      k += m;
+    }
+    i += n;
   }
   Bus::setCCT(oldCCT);  // restore old CCT for ABL adjustments
-
-  p_free(_pixelCCT);
-  _pixelCCT = nullptr;
+  _paintTiming.add(micros() - t0);
 
   // some buses send asynchronously and this method will return before
   // all of the data has been sent.
   // See https://github.com/Makuna/NeoPixelBus/wiki/ESP32-NeoMethods#neoesp32rmt-methods
+  t0 = micros();
   BusManager::show();
+  _busShowTiming.add(micros() - t0);
+}
 
-  if (diff > 0) { // skip calculation if no time has passed
-    size_t fpsCurr = (1000 << FPS_CALC_SHIFT) / diff; // fixed point math
-    _cumulativeFps = (FPS_CALC_AVG * _cumulativeFps + fpsCurr + FPS_CALC_AVG / 2) / (FPS_CALC_AVG + 1);   // "+FPS_CALC_AVG/2" for proper rounding
-    _lastShow = showNow;
+#ifdef WLED_ENABLE_PIPELINED_OUTPUT
+// pipelined output: service() composes frame N+1 into _pixels while the output task sends frame N from _outPixels
+// output is started at the beginning of the next service() and finished before service() returns so nothing
+// else (JSON API, realtime, bus re-init) can touch buses while the output task is using them
+void WS2812FX::outputTask(void *param) {
+  WS2812FX *instance = static_cast<WS2812FX*>(param);
+  for (;;) {
+    if (xSemaphoreTake(instance->_outputStart, portMAX_DELAY) != pdTRUE) continue;
+    instance->paintFrame(instance->_outPixels, instance->_outPixelCCT, instance->_outCCT);
+    xSemaphoreGive(instance->_outputDone);
   }
 }
 
+void WS2812FX::startOutput() {
+  _outputPending = false;
+  _outputBusy = true;
+  updateFps(millis());
+  xSemaphoreGive(_outputStart);
+}
+
+void WS2812FX::waitForOutput() {
+  if (!_outputBusy) return;
+  xSemaphoreTake(_outputDone, portMAX_DELAY);
+  _outputBusy = false;
+}
+
+// composes the frame and copies it for the output task, returns false if frame needs to be shown directly
+bool WS2812FX::queueFrame() {
+  if (!_outputTask || !_outPixels || !_pixels) return false;
+  const int cct = composeFrame();  // overlaps with output of previous frame
+  if (cct == CCT_PER_PIXEL && !_outPixelCCT)
+    _outPixelCCT = static_cast<uint8_t*>(allocate_buffer(getLengthTotal() * sizeof(uint8_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_TAG(ALLOC_TAG_CCT)));
+  waitForOutput();
+  if (cct == CCT_PER_PIXEL && !_outPixelCCT) { // out of memory, show directly
+    paintFrame(_pixels, _pixelCCT, cct);
+    updateFps(millis());
+    return true;
+  }
+  memcpy(_outPixels, _pixels, getLengthTotal() * sizeof(uint32_t));
+  if (cct == CCT_PER_PIXEL) memcpy(_outPixelCCT, _pixelCCT, getLengthTotal() * sizeof(uint8_t));
+  _outCCT = cct;
+  _outputPending = true;
+  return true;
+}
+#endif
+
+// returns false if frame buffer (and LEDs) would not change by compositing segments again
+// segments are marked dirty when their pixels change (see Segment::setPixelColorRaw())
+bool WS2812FX::hasFrameChanged(unsigned long nowUp) const {
+  if (_triggered || !_frameValid || _isOffRefreshRequired) return true;
+  if (realtimeMode != REALTIME_MODE_INACTIVE || overlayCurrent || UsermodManager::hasOverlay()) return true; // realtime data and overlays are not tracked
+  if (nowUp - _lastShow >= MAX_IDLE_SHOW_DELAY) return true;
+  unsigned blended = 0;
+  for (const Segment &seg : _segments) {
+    if (!seg.isActive() || !(seg.on || seg.isInTransition())) continue;
+    if (seg._dirty || seg.isInTransition()) return true;
+    blended++;
+  }
+  return blended != _blendedSegments; // segment was turned on/off or removed
+}
+
+// returns true if frame shown last would not change by running service() again: all active segments are
+// static or frozen and nothing that is not tracked by segments (realtime data, overlay, brightness) is pending
+// usermod overlays are drawn in the show callback and cannot be tracked, so a strip with overlay usermods is never static
+bool WS2812FX::isFrameStatic() const {
+  if (_triggered || !_frameValid || _isOffRefreshRequired) return false;
+  if (realtimeMode != REALTIME_MODE_INACTIVE || overlayCurrent || UsermodManager::hasOverlay()) return false;
+  if (millis() - _lastShow >= MAX_IDLE_SHOW_DELAY) return false;
+  #ifdef WLED_ENABLE_PIPELINED_OUTPUT
+  if (_outputPending) return false; // last frame has not been sent yet
+  #endif
+  for (const Segment &seg : _segments) {
+    if (!seg.isActive() || !(seg.on || seg.isInTransition())) continue;
+    if (seg._dirty || seg.reset || seg.isInTransition()) return false;
+    if (!seg.freeze && seg.mode != FX_MODE_STATIC) return false;
+  }
+  return true;
+}
+
+// idle strip is not serviced by loop(); any change of state ends idle: trigger() (stateUpdated() issues it if
+// there is no transition), transition, brightness change, segment colors, palette, pixels or reset, realtime data,
+// overlay (built-in or usermod) or MAX_IDLE_SHOW_DELAY elapsed since last show (periodic refresh)
+bool WS2812FX::isIdle() {
+  if (!_idle) return false;
+  if (isFrameStatic()) return true;
+  _idle = false;
+  _idleFrames = getIdleFrames();
+  return false;
+}
+
+uint32_t WS2812FX::getIdleFrames() const {
+  if (!_idle) return _idleFrames;
+  return _idleFrames + (uint64_t)(millis() - _idleSince) * 1000ULL / _frameTimeUs;
+}
+
 void WS2812FX::setRealtimePixelColor(unsigned i, uint32_t c) {
   if (useMainSegmentOnly) {
     const Segment &seg = getMainSegment();
@@ -1635,6 +2286,38 @@ void WS2812FX::setRealtimePixelColor(unsigned i, uint32_t c) {
   }
 }
 
+// bulk variant of setRealtimePixelColor(): unpacks count RGB (channels==3) or RGBW (channels==4) tuples from data into
+// consecutive pixels starting at i; bounds are checked once per call instead of once per pixel
+void WS2812FX::setRealtimePixels(unsigned i, const uint8_t *data, unsigned count, unsigned channels) {
+  uint32_t *dst = _pixels;
+  unsigned len = getLengthTotal();
+  const Segment *seg = nullptr;
+  if (useMainSegmentOnly) {
+    seg = &getMainSegment();
+    if (!seg->isActive()) return;
+    dst = seg->pixels;
+    len = seg->length();
+  }
+  if (!dst || i >= len || !data) return;
+  if (count > len - i) count = len - i;
+  dst += i;
+  uint32_t diff = 0; // accumulates changed bits so a segment is only marked dirty if its content changed
+  if (channels == 4) {
+    for (unsigned n = 0; n < count; n++, data += 4) {
+      const uint32_t c = RGBW32(data[0], data[1], data[2], data[3]);
+      diff |= dst[n] ^ c;
+      dst[n] = c;
+    }
+  } else if (channels == 3) {
+    for (unsigned n = 0; n < count; n++, data += 3) {
+      const uint32_t c = RGBW32(data[0], data[1], data[2], 0);
+      diff |= dst[n] ^ c;
+      dst[n] = c;
+    }
+  }
+  if (seg && diff) seg->_dirty = true;
+}
+
 // reset all segments
 void WS2812FX::restartRuntime() {
   suspend();
@@ -1643,6 +2326,14 @@ void WS2812FX::restartRuntime() {
   resume();
 }
 
+#ifdef WLED_ENABLE_DETERMINISTIC_RNG
+// same seed and timebase will render identical frames (segments are reseeded when their effect restarts)
+void WS2812FX::setRandomSeed(uint32_t seed) {
+  _rngSeed = seed;
+  restartRuntime();
+}
+#endif
+
 // start or stop transition for all segments
 void WS2812FX::setTransitionMode(bool t) {
   suspend();
@@ -1664,6 +2355,7 @@ void WS2812FX::setTargetFps(unsigned fps) {
   if (fps <= 250) _targetFps = fps;
   if (_targetFps > 0) _frametime = 1000 / _targetFps;
   else _frametime = MIN_FRAME_DELAY;     // unlimited mode
+  _frameTimeUs = _targetFps > 0 ? 1000000UL / _targetFps : MIN_FRAME_DELAY * 1000UL;
 }
 
 void WS2812FX::setCCT(uint16_t k) {
@@ -1680,6 +2372,7 @@ void WS2812FX::setBrightness(uint8_t b, bool direct) {
   if (gammaCorrectBri) b = gamma8(b);
   if (_brightness == b) return;
   _brightness = b;
+  _frameValid = false;  // LEDs need update with new brightness
   if (_brightness == 0) { //unfreeze all segments on power off
     for (const Segment &seg : _segments) seg.freeze = false; // freeze is mutable
   }
@@ -1919,14 +2612,169 @@ void WS2812FX::printSize() {
 }
 #endif
 
+// Compiled ledmap cache: the first time ledmapN.json is loaded its table is stored as /ledmapN.bin
+// and subsequent loads (boot, preset/playlist ledmap switch) read the binary file instead of parsing JSON.
+// The cache is tied to the JSON file content (size and checksum, so edits via the FS editor are detected)
+// and is removed when a ledmap JSON is uploaded.
+// Layout: ledmap_bin_header_t followed by runs, each starting with a uint16_t (bits 15-14 run type,
+// bits 13-0 run length) and followed by:
+//  LEDMAP_RUN_LITERAL - length x uint16_t table entries
+//  LEDMAP_RUN_ASCEND  - one uint16_t start index, next entries are index+1, index+2, ... (a matrix row)
+//  LEDMAP_RUN_DESCEND - one uint16_t start index, next entries are index-1, index-2, ... (serpentine row)
+//  LEDMAP_RUN_FILL    - one uint16_t index repeated length times (gaps)
+#define LEDMAP_BIN_MAGIC    0x324D4C57 // "WLM2" little endian
+#define LEDMAP_BIN_HASDIMS  0x01       // width & height were present in JSON
+#define LEDMAP_BIN_TRUNCATED 0x02      // JSON map had more entries than LEDs at the time of compilation
+#define LEDMAP_RUN_LITERAL  0
+#define LEDMAP_RUN_ASCEND   1
+#define LEDMAP_RUN_DESCEND  2
+#define LEDMAP_RUN_FILL     3
+#define LEDMAP_RUN_MAXLEN   0x3FFF
+
+typedef struct __attribute__((packed)) {
+  uint32_t magic;
+  uint32_t srcSize;  // size of ledmapN.json the table was compiled from
+  uint32_t srcHash;  // FNV-1a checksum of ledmapN.json
+  uint16_t count;    // number of table entries
+  uint8_t  width;    // Segment::maxWidth from JSON (if LEDMAP_BIN_HASDIMS)
+  uint8_t  height;   // Segment::maxHeight from JSON (if LEDMAP_BIN_HASDIMS)
+  uint8_t  flags;
+  uint8_t  reserved[3];
+} ledmap_bin_header_t;
+
+static void getLedmapFileName(char *fileName, unsigned n, bool compiled) {
+  strcpy_P(fileName, PSTR("/ledmap"));
+  if (n) sprintf(fileName +7, "%d", n);
+  strcat_P(fileName, compiled ? PSTR(".bin") : PSTR(".json"));
+}
+
+// FNV-1a checksum of the whole file (reading is much cheaper than parsing the JSON)
+static uint32_t ledmapChecksum(File &f) {
+  uint8_t buf[128];
+  uint32_t hash = 2166136261UL;
+  size_t len;
+  while ((len = f.read(buf, sizeof(buf))) > 0)
+    for (size_t i = 0; i < len; i++) hash = (hash ^ buf[i]) * 16777619UL;
+  return hash;
+}
+
+// how many entries starting at table[i] follow the given run type (at most max)
+static unsigned ledmapRunLength(const uint16_t *table, unsigned i, unsigned max, unsigned type) {
+  unsigned len = 1;
+  while (len < max) {
+    uint16_t prev = table[i+len-1], cur = table[i+len];
+    if      (type == LEDMAP_RUN_ASCEND)  { if (cur != prev+1) break; }
+    else if (type == LEDMAP_RUN_DESCEND) { if (cur != prev-1) break; }
+    else if (cur != prev) break;
+    len++;
+  }
+  return len;
+}
+
+static bool writeLedmapRun(File &f, unsigned type, unsigned len, const uint16_t *data) {
+  uint16_t hdr = (type << 14) | len;
+  size_t dataLen = (type == LEDMAP_RUN_LITERAL ? len : 1) * sizeof(uint16_t);
+  return f.write(reinterpret_cast<const uint8_t*>(&hdr), sizeof(hdr)) == sizeof(hdr)
+      && f.write(reinterpret_cast<const uint8_t*>(data), dataLen) == dataLen;
+}
+
+// store the mapping table in compiled form (returns number of bytes written or 0 on failure)
+static size_t saveLedmapCache(const char *fileName, const ledmap_bin_header_t &hdr, const uint16_t *table) {
+  File f = WLED_FS.open(fileName, "w");
+  if (!f) return 0;
+  bool ok = f.write(reinterpret_cast<const uint8_t*>(&hdr), sizeof(hdr)) == sizeof(hdr);
+  unsigned i = 0, literal = 0; // literal = start of pending literal run
+  while (ok && i < hdr.count) {
+    unsigned max = min((unsigned)hdr.count - i, (unsigned)LEDMAP_RUN_MAXLEN);
+    unsigned type = LEDMAP_RUN_FILL;
+    unsigned len  = ledmapRunLength(table, i, max, LEDMAP_RUN_FILL);
+    for (unsigned t = LEDMAP_RUN_ASCEND; t <= LEDMAP_RUN_DESCEND; t++) {
+      unsigned l = ledmapRunLength(table, i, max, t);
+      if (l > len) { len = l; type = t; }
+    }
+    if (len < 3) { // not worth a run of its own (a run costs 2 entries)
+      i++;
+      if (i - literal < LEDMAP_RUN_MAXLEN && i < hdr.count) continue;
+      type = LEDMAP_RUN_LITERAL;
+      len  = 0;
+    }
+    if (i > literal) ok = writeLedmapRun(f, LEDMAP_RUN_LITERAL, i - literal, table + literal);
+    if (ok && len) ok = writeLedmapRun(f, type, len, table + i);
+    i += len;
+    literal = i;
+  }
+  size_t size = f.size();
+  f.close();
+  if (!ok) {
+    WLED_FS.remove(fileName); // FS full or other error, do not leave a truncated cache behind
+    return 0;
+  }
+  return size;
+}
+
+// read compiled table into table[] (sized hdr.count), file must be positioned after header
+static bool loadLedmapCache(File &f, const ledmap_bin_header_t &hdr, uint16_t *table) {
+  unsigned i = 0;
+  while (i < hdr.count) {
+    uint16_t run, val;
+    if (f.read(reinterpret_cast<uint8_t*>(&run), sizeof(run)) != sizeof(run)) return false;
+    unsigned type = run >> 14;
+    unsigned len  = run & LEDMAP_RUN_MAXLEN;
+    if (len == 0 || i + len > hdr.count) return false;
+    if (type == LEDMAP_RUN_LITERAL) {
+      if (f.read(reinterpret_cast<uint8_t*>(table + i), len * sizeof(uint16_t)) != len * sizeof(uint16_t)) return false;
+      i += len;
+      continue;
+    }
+    if (f.read(reinterpret_cast<uint8_t*>(&val), sizeof(val)) != sizeof(val)) return false;
+    int step = type == LEDMAP_RUN_ASCEND ? 1 : type == LEDMAP_RUN_DESCEND ? -1 : 0;
+    for (unsigned j = 0; j < len; j++, val += step) table[i++] = val;
+  }
+  return true;
+}
+
+// parse "map" array from ledmap JSON in chunks (much faster than reading number by number)
+// negative or out of range indices become 0xFFFF (unused LED), returns number of entries read
+// truncated is set if the map has more than maxSize entries
+static unsigned parseLedmapJSON(File &f, uint16_t *table, unsigned maxSize, bool &truncated) {
+  unsigned count = 0;
+  truncated = false;
+  if (!f.find("\"map\":[")) return 0;
+  uint8_t buf[128];
+  int  value = 0;
+  bool negative = false, digit = false, done = false;
+  size_t len;
+  while (!done && (len = f.read(buf, sizeof(buf))) > 0) {
+    for (size_t i = 0; i < len; i++) {
+      char c = buf[i];
+      if (c >= '0' && c <= '9') {
+        if (value <= 16384) value = value * 10 + (c - '0');
+        digit = true;
+      } else if (c == '-') {
+        negative = true;
+      } else if (c == ',' || c == ']') {
+        if (c == ']' && !digit) { done = true; break; } // empty array or trailing separator
+        if (count == maxSize) { truncated = done = true; break; }
+        table[count++] = (negative || value > 16384) ? 0xFFFF : value;
+        value = 0; negative = digit = false;
+        if (c == ']') { done = true; break; }
+      }
+    }
+  }
+  return count;
+}
+
 // load custom mapping table from JSON file (called from finalizeInit() or deserializeState())
 // if this is a matrix set-up and default ledmap.json file does not exist, create mapping table using setUpMatrix() from panel information
+// a compiled copy of the table is kept in /ledmapN.bin and used instead of JSON when it is up to date
 bool WS2812FX::deserializeMap(unsigned n) {
   char fileName[32];
-  strcpy_P(fileName, PSTR("/ledmap"));
-  if (n) sprintf(fileName +7, "%d", n);
-  strcat_P(fileName, PSTR(".json"));
-  bool isFile = WLED_FS.exists(fileName);
+  getLedmapFileName(fileName, n, false);
+  File jsonFile = WLED_FS.open(fileName, "r");
+  bool isFile = (bool)jsonFile;
+  size_t jsonSize = isFile ? jsonFile.size() : 0;
+  uint32_t jsonHash = isFile ? ledmapChecksum(jsonFile) : 0;
+  jsonFile.close();
 
   customMappingSize = 0; // prevent use of mapping if anything goes wrong
   currentLedmap = 0;
@@ -1938,57 +2786,78 @@ bool WS2812FX::deserializeMap(unsigned n) {
     return false;
   }
 
-  if (!isFile || !requestJSONBufferLock(7)) return false;
-
-  StaticJsonDocument<64> filter;
-  filter[F("width")]  = true;
-  filter[F("height")] = true;
-  if (!readObjectFromFile(fileName, nullptr, pDoc, &filter)) {
-    DEBUG_PRINTF_P(PSTR("ERROR Invalid ledmap in %s\n"), fileName);
+  if (!isFile) return false;
+
+  char cacheName[32];
+  getLedmapFileName(cacheName, n, true);
+  ledmap_bin_header_t hdr;
+  File f = WLED_FS.open(cacheName, "r");
+  // cache is compiled for the current LED count (recompile if the count shrunk below or grew past a truncated table)
+  bool cached = f && f.read(reinterpret_cast<uint8_t*>(&hdr), sizeof(hdr)) == sizeof(hdr)
+             && hdr.magic == LEDMAP_BIN_MAGIC && hdr.srcSize == jsonSize && hdr.srcHash == jsonHash && hdr.count <= getLengthTotal()
+             && (!(hdr.flags & LEDMAP_BIN_TRUNCATED) || hdr.count == getLengthTotal());
+  if (!cached) {
+    if (f) f.close();
+    if (!requestJSONBufferLock(7)) return false;
+    StaticJsonDocument<64> filter;
+    filter[F("width")]  = true;
+    filter[F("height")] = true;
+    if (!readObjectFromFile(fileName, nullptr, pDoc, &filter)) {
+      DEBUG_PRINTF_P(PSTR("ERROR Invalid ledmap in %s\n"), fileName);
+      releaseJSONBufferLock();
+      return false; // if file does not load properly then exit
+    }
+    JsonObject root = pDoc->as<JsonObject>();
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic   = LEDMAP_BIN_MAGIC;
+    hdr.srcSize = jsonSize;
+    hdr.srcHash = jsonHash;
+    if (!root[F("width")].isNull() || !root[F("height")].isNull()) {
+      hdr.flags |= LEDMAP_BIN_HASDIMS;
+      hdr.width  = min(max(root[F("width")].as<int>(), 1), 255);
+      hdr.height = min(max(root[F("height")].as<int>(), 1), 255);
+    }
     releaseJSONBufferLock();
-    return false; // if file does not load properly then exit
-  } else
+    f = WLED_FS.open(fileName, "r");
     DEBUG_PRINTF_P(PSTR("Reading LED map from %s\n"), fileName);
+  } else {
+    DEBUG_PRINTF_P(PSTR("Reading LED map from %s\n"), cacheName);
+  }
 
   suspend();
   waitForIt();
 
-  JsonObject root = pDoc->as<JsonObject>();
   // if we are loading default ledmap (at boot) set matrix width and height from the ledmap (compatible with WLED MM ledmaps)
-  if (n == 0 && (!root[F("width")].isNull() || !root[F("height")].isNull())) {
-    Segment::maxWidth  = min(max(root[F("width")].as<int>(), 1), 255);
-    Segment::maxHeight = min(max(root[F("height")].as<int>(), 1), 255);
+  if (n == 0 && (hdr.flags & LEDMAP_BIN_HASDIMS)) {
+    Segment::maxWidth  = hdr.width;
+    Segment::maxHeight = hdr.height;
     isMatrix = true;
   }
 
   d_free(customMappingTable);
-  customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // prefer DRAM for speed
+  customMappingTable = static_cast<uint16_t*>(tagAllocation(d_malloc(sizeof(uint16_t)*getLengthTotal()), ALLOC_TAG_LEDMAP)); // prefer DRAM for speed
 
   if (customMappingTable) {
     DEBUG_PRINTF_P(PSTR("ledmap allocated: %uB\n"), sizeof(uint16_t)*getLengthTotal());
-    File f = WLED_FS.open(fileName, "r");
-    f.find("\"map\":[");
-    while (f.available()) { // f.position() < f.size() - 1
-      char number[32];
-      size_t numRead = f.readBytesUntil(',', number, sizeof(number)-1); // read a single number (may include array terminating "]" but not number separator ',')
-      number[numRead] = 0;
-      if (numRead > 0) {
-        char *end = strchr(number,']'); // we encountered end of array so stop processing if no digit found
-        bool foundDigit = (end == nullptr);
-        int i = 0;
-        if (end != nullptr) do {
-          if (number[i] >= '0' && number[i] <= '9') foundDigit = true;
-          if (foundDigit || &number[i++] == end) break;
-        } while (i < 32);
-        if (!foundDigit) break;
-        int index = atoi(number);
-        if (index < 0 || index > 16384) index = 0xFFFF;
-        customMappingTable[customMappingSize++] = index;
-        if (customMappingSize > getLengthTotal()) break;
-      } else break; // there was nothing to read, stop
+    if (cached) {
+      bool ok = loadLedmapCache(f, hdr, customMappingTable);
+      f.close();
+      if (ok) customMappingSize = hdr.count;
+      else {
+        DEBUG_PRINTF_P(PSTR("ERROR Invalid ledmap cache %s\n"), cacheName);
+        WLED_FS.remove(cacheName); // will be recompiled on next load
+      }
+    } else {
+      bool truncated = false;
+      hdr.count = customMappingSize = parseLedmapJSON(f, customMappingTable, getLengthTotal(), truncated);
+      if (truncated) hdr.flags |= LEDMAP_BIN_TRUNCATED;
+      f.close();
+      if (customMappingSize) {
+        [[maybe_unused]] size_t size = saveLedmapCache(cacheName, hdr, customMappingTable);
+        DEBUG_PRINTF_P(PSTR("Compiled ledmap to %s: %uB\n"), cacheName, size);
+      }
     }
     currentLedmap = n;
-    f.close();
 
     #ifdef WLED_DEBUG
     DEBUG_PRINT(F("Loaded ledmap:"));
@@ -1998,21 +2867,13 @@ bool WS2812FX::deserializeMap(unsigned n) {
     }
     DEBUG_PRINTLN();
     #endif
-/*
-    JsonArray map = root[F("map")];
-    if (!map.isNull() && map.size()) {  // not an empty map
-      customMappingSize = min((unsigned)map.size(), (unsigned)getLengthTotal());
-      for (unsigned i=0; i<customMappingSize; i++) customMappingTable[i] = (uint16_t) (map[i]<0 ? 0xFFFFU : map[i]);
-      currentLedmap = n;
-    }
-*/
   } else {
+    if (f) f.close();
     DEBUG_PRINTLN(F("ERROR LED map allocation error."));
   }
 
   resume();
 
-  releaseJSONBufferLock();
   return (customMappingSize > 0);
 }
 
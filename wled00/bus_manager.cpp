@@ -25,7 +25,11 @@
 #include "colors.h"
 #include "pin_manager.h"
 #include "bus_manager.h"
+#ifndef WLED_HOST_BUILD
 #include "bus_wrapper.h"
+#else
+#include "HostPolyBus.h" // in-memory buses for the host (native) build
+#endif
 #include <bits/unique_ptr.h>
 
 extern char cmDNS[];
@@ -45,17 +49,13 @@ extern "C" {
   void *d_malloc(size_t);
   void *d_calloc(size_t, size_t);
   void *d_realloc_malloc(void *ptr, size_t size);
-  #ifndef ESP8266
-  inline void d_free(void *ptr) { heap_caps_free(ptr); }
-  #else
-  inline void d_free(void *ptr) { free(ptr); }
-  #endif
+  void d_free(void *ptr);
   #if defined(BOARD_HAS_PSRAM)
   // prefer PSRAM over DRAM in p_ alloc functions
   void *p_malloc(size_t);
   void *p_calloc(size_t, size_t);
   void *p_realloc_malloc(void *ptr, size_t size);
-  inline void p_free(void *ptr) { heap_caps_free(ptr); }
+  inline void p_free(void *ptr) { d_free(ptr); }
   #else
   #define p_malloc d_malloc
   #define p_calloc d_calloc
@@ -76,6 +76,7 @@ static ColorOrderMap _colorOrderMap = {};
 bool ColorOrderMap::add(uint16_t start, uint16_t len, uint8_t colorOrder) {
   if (count() >= WLED_MAX_COLOR_ORDER_MAPPINGS || len == 0 || (colorOrder & 0x0F) > COL_ORDER_MAX) return false; // upper nibble contains W swap information
   _mappings.push_back({start,len,colorOrder});
+  _version++;
   DEBUGBUS_PRINTF_P(PSTR("Bus: Add COM (%d,%d,%d)\n"), (int)start, (int)len, (int)colorOrder);
   return true;
 }
@@ -173,6 +174,24 @@ BusDigital::BusDigital(const BusConfig &bc, uint8_t nr)
     (unsigned)_iType,
     (int)_milliAmpsPerLed, (int)_milliAmpsMax
   );
+  resolveColorOrder();
+}
+
+// splits the bus into runs of pixels with the same color order so output does not need to search ColorOrderMap for each pixel
+// called whenever the map or bus color order changes (not from output path as it allocates)
+void BusDigital::resolveColorOrder() {
+  _coRuns.clear();
+  if (_colorOrderMap.count() > 0) {
+    bool mapped = false;
+    for (unsigned p = 0; p < _len + _skip; p++) {
+      const uint8_t co = _colorOrderMap.getPixelColorOrder(p+_start, _colorOrder);
+      if (_coRuns.empty() || _coRuns.back().colorOrder != co) _coRuns.push_back({uint16_t(p), co});
+      mapped |= co != _colorOrder;
+    }
+    if (!mapped) _coRuns.clear(); // map does not cover this bus
+  }
+  _coRuns.shrink_to_fit();
+  DEBUGBUS_PRINTF_P(PSTR("Bus: %u color order runs\n"), _coRuns.size());
 }
 
 //DISCLAIMER
@@ -223,8 +242,9 @@ void BusDigital::applyBriLimit(uint8_t newBri) {
     uint8_t cctWW = 0, cctCW = 0;
     unsigned hwLen = _len;
     if (_type == TYPE_WS2812_1CH_X3) hwLen = NUM_ICS_WS2812_1CH_3X(_len); // only needs a third of "RGB" LEDs for NeoPixelBus
+    size_t coRun = 0;
     for (unsigned i = 0; i < hwLen; i++) {
-      uint8_t co = _colorOrderMap.getPixelColorOrder(i+_start, _colorOrder); // need to revert color order for correct color scaling and CCT calc in case white is swapped
+      uint8_t co = _coRuns.empty() ? _colorOrder : colorOrderAt(i, coRun); // need to revert color order for correct color scaling and CCT calc in case white is swapped
       uint32_t c = PolyBus::getPixelColor(_busPtr, _iType, i, co);
       c = color_fade(c, newBri, true); // apply additional dimming  note: using inline version is a bit faster but overhead of getPixelColor() dominates the speed impact by far
       if (hasCCT()) Bus::calculateCCT(c, cctWW, cctCW);
@@ -249,48 +269,61 @@ bool BusDigital::canShow() const {
 //TODO only show if no new show due in the next 50ms
 void BusDigital::setStatusPixel(uint32_t c) {
   if (_valid && _skip) {
-    PolyBus::setPixelColor(_busPtr, _iType, 0, c, _colorOrderMap.getPixelColorOrder(_start, _colorOrder));
+    PolyBus::setPixelColor(_busPtr, _iType, 0, c, _coRuns.empty() ? _colorOrder : _coRuns[0].colorOrder);
     if (canShow()) PolyBus::show(_busPtr, _iType);
   }
 }
 
-void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
+// sets len consecutive pixels starting at pix (relative to bus start)
+// checks that do not change within a run are done once, color order is taken from pre-resolved runs
+void IRAM_ATTR BusDigital::setPixels(unsigned pix, const uint32_t *colors, size_t len) {
   if (!_valid) return;
-  if (hasWhite()) c = autoWhiteCalc(c);
-  if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
-  c = color_fade(c, _bri, true); // apply brightness
-
-  if (BusManager::_useABL) {
-    // if using ABL, sum all color channels to estimate current and limit brightness in show()
-    uint8_t r = R(c), g = G(c), b = B(c);
-    if (_milliAmpsPerLed < 255) { // normal ABL
-      _colorSum += r + g + b + W(c);
-    } else { // wacky WS2815 power model, ignore white channel, use max of RGB (issue #549)
-      _colorSum += ((r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b));
+  if (pix + len > _len) len = pix < _len ? _len - pix : 0;
+  const bool    autoWhite = hasWhite();
+  const int16_t kelvin    = Bus::_cct >= 1900 ? Bus::_cct : 0; //color correction from CCT
+  const bool    mapCO     = !_coRuns.empty();
+  uint8_t       co        = _colorOrder;
+  size_t        coRun     = 0;
+
+  for (size_t i = 0; i < len; i++) {
+    uint32_t c = colors[i];
+    if (autoWhite) c = autoWhiteCalc(c);
+    if (kelvin) c = colorBalanceFromKelvin(kelvin, c);
+    c = color_fade(c, _bri, true); // apply brightness
+
+    if (BusManager::_useABL) {
+      // if using ABL, sum all color channels to estimate current and limit brightness in show()
+      uint8_t r = R(c), g = G(c), b = B(c);
+      if (_milliAmpsPerLed < 255) { // normal ABL
+        _colorSum += r + g + b + W(c);
+      } else { // wacky WS2815 power model, ignore white channel, use max of RGB (issue #549)
+        _colorSum += ((r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b));
+      }
     }
-  }
 
-  if (_reversed) pix = _len - pix -1;
-  pix += _skip;
-  const uint8_t co = _colorOrderMap.getPixelColorOrder(pix+_start, _colorOrder);
-  if (_type == TYPE_WS2812_1CH_X3) { // map to correct IC, each controls 3 LEDs
-    unsigned pOld = pix;
-    pix = IC_INDEX_WS2812_1CH_3X(pix);
-    uint32_t cOld = PolyBus::getPixelColor(_busPtr, _iType, pix, co);
-    switch (pOld % 3) { // change only the single channel (TODO: this can cause loss because of get/set)
-      case 0: c = RGBW32(R(cOld), W(c)   , B(cOld), 0); break;
-      case 1: c = RGBW32(W(c)   , G(cOld), B(cOld), 0); break;
-      case 2: c = RGBW32(R(cOld), G(cOld), W(c)   , 0); break;
+    unsigned p = pix + i;
+    if (_reversed) p = _len - p -1;
+    p += _skip;
+    if (mapCO) co = colorOrderAt(p, coRun);
+    if (_type == TYPE_WS2812_1CH_X3) { // map to correct IC, each controls 3 LEDs
+      unsigned pOld = p;
+      p = IC_INDEX_WS2812_1CH_3X(p);
+      uint32_t cOld = PolyBus::getPixelColor(_busPtr, _iType, p, co);
+      switch (pOld % 3) { // change only the single channel (TODO: this can cause loss because of get/set)
+        case 0: c = RGBW32(R(cOld), W(c)   , B(cOld), 0); break;
+        case 1: c = RGBW32(W(c)   , G(cOld), B(cOld), 0); break;
+        case 2: c = RGBW32(R(cOld), G(cOld), W(c)   , 0); break;
+      }
     }
+    uint16_t wwcw = 0;
+    if (hasCCT()) {
+      uint8_t cctWW = 0, cctCW = 0;
+      Bus::calculateCCT(c, cctWW, cctCW);
+      wwcw = (cctCW<<8) | cctWW;
+      if (_type == TYPE_WS2812_WWA) c = RGBW32(cctWW, cctCW, 0, W(c));
+    }
+    PolyBus::setPixelColor(_busPtr, _iType, p, c, co, wwcw);
   }
-  uint16_t wwcw = 0;
-  if (hasCCT()) {
-    uint8_t cctWW = 0, cctCW = 0;
-    Bus::calculateCCT(c, cctWW, cctCW);
-    wwcw = (cctCW<<8) | cctWW;
-    if (_type == TYPE_WS2812_WWA) c = RGBW32(cctWW, cctCW, 0, W(c));
-  }
-  PolyBus::setPixelColor(_busPtr, _iType, pix, c, co, wwcw);
 }
 
 // returns lossly restored color from bus
@@ -298,7 +331,7 @@ uint32_t IRAM_ATTR BusDigital::getPixelColor(unsigned pix) const {
   if (!_valid) return 0;
   if (_reversed) pix = _len - pix -1;
   pix += _skip;
-  const uint8_t co = _colorOrderMap.getPixelColorOrder(pix+_start, _colorOrder);
+  const uint8_t co = _coRuns.empty() ? _colorOrder : colorOrderAt(pix);
   uint32_t c = restoreColorLossy(PolyBus::getPixelColor(_busPtr, _iType, (_type==TYPE_WS2812_1CH_X3) ? IC_INDEX_WS2812_1CH_3X(pix) : pix, co),_bri);
   if (_type == TYPE_WS2812_1CH_X3) { // map to correct IC, each controls 3 LEDs
     uint8_t r = R(c);
@@ -324,13 +357,14 @@ size_t BusDigital::getPins(uint8_t* pinArray) const {
 }
 
 size_t BusDigital::getBusSize() const {
-  return sizeof(BusDigital) + (isOk() ? PolyBus::getDataSize(_busPtr, _iType) : 0);
+  return sizeof(BusDigital) + _coRuns.capacity() * sizeof(co_run_t) + (isOk() ? PolyBus::getDataSize(_busPtr, _iType) : 0);
 }
 
 void BusDigital::setColorOrder(uint8_t colorOrder) {
   // upper nibble contains W swap information
   if ((colorOrder & 0x0F) > 5) return;
   _colorOrder = colorOrder;
+  resolveColorOrder();
 }
 
 // credit @willmmiles & @netmindz https://github.com/wled/WLED/pull/4056
@@ -689,15 +723,20 @@ BusNetwork::BusNetwork(const BusConfig &bc)
   DEBUGBUS_PRINTF_P(PSTR("%successfully inited virtual strip with type %u and IP %u.%u.%u.%u\n"), _valid?"S":"Uns", bc.type, bc.pins[0], bc.pins[1], bc.pins[2], bc.pins[3]);
 }
 
-void BusNetwork::setPixelColor(unsigned pix, uint32_t c) {
+void BusNetwork::setPixels(unsigned pix, const uint32_t *colors, size_t len) {
   if (!_valid || pix >= _len) return;
-  if (_hasWhite) c = autoWhiteCalc(c);
-  if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
-  unsigned offset = pix * _UDPchannels;
-  _data[offset]   = R(c);
-  _data[offset+1] = G(c);
-  _data[offset+2] = B(c);
-  if (_hasWhite) _data[offset+3] = W(c);
+  if (pix + len > _len) len = _len - pix;
+  const int16_t kelvin = Bus::_cct >= 1900 ? Bus::_cct : 0; //color correction from CCT
+  uint8_t *data = _data + pix * _UDPchannels;
+  for (size_t i = 0; i < len; i++, data += _UDPchannels) {
+    uint32_t c = colors[i];
+    if (_hasWhite) c = autoWhiteCalc(c);
+    if (kelvin) c = colorBalanceFromKelvin(kelvin, c);
+    data[0] = R(c);
+    data[1] = G(c);
+    data[2] = B(c);
+    if (_hasWhite) data[3] = W(c);
+  }
 }
 
 uint32_t BusNetwork::getPixelColor(unsigned pix) const {
@@ -817,9 +856,57 @@ int BusManager::add(const BusConfig &bc) {
   } else {
     busses.push_back(make_unique<BusPwm>(bc));
   }
+  rebuildRouting();
   return busses.size();
 }
 
+// pixel to bus routing table: one entry per (non-empty) bus sorted by start index
+// lookups start at the route of the previous lookup as consecutive pixels usually land on the same bus
+typedef struct {
+  unsigned start;
+  unsigned end;   // exclusive
+  unsigned bus;   // index into busses
+} bus_route_t;
+
+#define BUS_ROUTING_MIN 5 // with fewer buses scanning all of them is faster than the cached route check
+
+static std::vector<bus_route_t> _busRoutes;
+static size_t _lastRoute    = 0;
+static bool   _scanBuses    = true;  // scan all buses instead of routing: overlapping buses (all receive the shared pixels) or only a few buses
+
+void BusManager::rebuildRouting() {
+  _busRoutes.clear();
+  _busRoutes.reserve(busses.size());
+  for (unsigned i = 0; i < busses.size(); i++) {
+    const unsigned len = busses[i]->getLength();
+    if (len) _busRoutes.push_back({busses[i]->getStart(), busses[i]->getStart() + len, i});
+  }
+  std::sort(_busRoutes.begin(), _busRoutes.end(), [](const bus_route_t &a, const bus_route_t &b) { return a.start < b.start; });
+  _scanBuses = busses.size() < BUS_ROUTING_MIN;
+  for (size_t i = 1; i < _busRoutes.size(); i++) if (_busRoutes[i].start < _busRoutes[i-1].end) _scanBuses = true; // buses overlap
+  _lastRoute = 0;
+  DEBUGBUS_PRINTF_P(PSTR("Bus: %u routes%s\n"), _busRoutes.size(), _scanBuses ? " (scanning)" : "");
+}
+
+// returns index of the route containing pix or the first route after it (_busRoutes.size() if there is none)
+static size_t IRAM_ATTR findRoute(unsigned pix) {
+  const size_t n = _busRoutes.size();
+  size_t r = _lastRoute;
+  if (r < n && pix >= _busRoutes[r].start) {
+    if (pix < _busRoutes[r].end) return r;                                                    // same bus as last time
+    if (++r < n && pix >= _busRoutes[r].start && pix < _busRoutes[r].end) return _lastRoute = r; // next bus
+  }
+  // binary search for the first route ending after pix
+  size_t lo = 0, hi = n;
+  while (lo < hi) {
+    const size_t mid = (lo + hi) / 2;
+    if (_busRoutes[mid].end <= pix) lo = mid + 1;
+    else hi = mid;
+  }
+  if (lo < n) _lastRoute = lo;
+  return lo;
+}
+
 // credit @willmmiles
 static String LEDTypesToJson(const std::vector<LEDType>& types) {
   String json;
@@ -860,6 +947,7 @@ void BusManager::removeAll() {
   //prevents crashes due to deleting busses while in use.
   while (!canAllShow()) yield();
   busses.clear();
+  rebuildRouting();
   PolyBus::setParallelI2S1Output(false);
 }
 
@@ -953,9 +1041,32 @@ void BusManager::show() {
 }
 
 void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
-  for (auto &bus : busses) {
-    if (!bus->containsPixel(pix)) continue;
-    bus->setPixelColor(pix - bus->getStart(), c);
+  if (_scanBuses) {
+    for (auto &bus : busses) if (bus->containsPixel(pix)) bus->setPixelColor(pix - bus->getStart(), c);
+    return;
+  }
+  const size_t r = findRoute(pix);
+  if (r < _busRoutes.size() && pix >= _busRoutes[r].start) busses[_busRoutes[r].bus]->setPixelColor(pix - _busRoutes[r].start, c);
+}
+
+// hands each bus the part of the run it contains
+void IRAM_ATTR BusManager::setPixels(unsigned pix, const uint32_t *c, size_t len) {
+  const unsigned end = pix + len;
+  if (_scanBuses) {
+    for (auto &bus : busses) {
+      const unsigned start = bus->getStart();
+      const unsigned from  = std::max(pix, start);
+      const unsigned to    = std::min(end, start + bus->getLength());
+      if (from < to) bus->setPixels(from - start, c + (from - pix), to - from);
+    }
+    return;
+  }
+  for (size_t r = findRoute(pix); r < _busRoutes.size() && _busRoutes[r].start < end; r++) {
+    const bus_route_t &route = _busRoutes[r];
+    const unsigned from = std::max(pix, route.start);
+    const unsigned to   = std::min(end, route.end);
+    busses[route.bus]->setPixels(from - route.start, c + (from - pix), to - from);
+    _lastRoute = r;
   }
 }
 
@@ -969,10 +1080,12 @@ void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
 }
 
 uint32_t BusManager::getPixelColor(unsigned pix) {
-  for (auto &bus : busses) {
-    if (!bus->containsPixel(pix)) continue;
-    return bus->getPixelColor(pix - bus->getStart());
+  if (_scanBuses) {
+    for (auto &bus : busses) if (bus->containsPixel(pix)) return bus->getPixelColor(pix - bus->getStart());
+    return 0;
   }
+  const size_t r = findRoute(pix);
+  if (r < _busRoutes.size() && pix >= _busRoutes[r].start) return busses[_busRoutes[r].bus]->getPixelColor(pix - _busRoutes[r].start);
   return 0;
 }
 
@@ -1062,6 +1175,15 @@ void BusManager::applyABL() {
 
 ColorOrderMap& BusManager::getColorOrderMap() { return _colorOrderMap; }
 
+// ColorOrderMap is edited from settings/config handlers, buses resolve it into color order runs here so that
+// the output path (which may run in the output task) never allocates; new buses resolve it when created
+void BusManager::updateColorOrderMap() {
+  static uint16_t resolvedVersion = 0;
+  if (_colorOrderMap.version() == resolvedVersion) return;
+  resolvedVersion = _colorOrderMap.version();
+  for (auto &bus : busses) if (bus->isDigital() && !bus->isVirtual()) static_cast<BusDigital&>(*bus).resolveColorOrder();
+}
+
 
 bool PolyBus::_useParallelI2S = false;
 
@@ -78,8 +78,11 @@ struct ColorOrderMap {
     void reset() {
       _mappings.clear();
       _mappings.shrink_to_fit();
+      _version++;
     }
 
+    inline uint16_t version() const { return _version; } // changes whenever mappings change (see BusManager::updateColorOrderMap())
+
     const ColorOrderMapEntry* get(uint8_t n) const {
       if (n >= count()) return nullptr;
       return &(_mappings[n]);
@@ -89,6 +92,7 @@ struct ColorOrderMap {
 
   private:
     std::vector<ColorOrderMapEntry> _mappings;
+    uint16_t _version = 0;
 };
 
 
@@ -121,6 +125,7 @@ class Bus {
     virtual bool     canShow() const                            { return true; }
     virtual void     setStatusPixel(uint32_t c)                 {}
     virtual void     setPixelColor(unsigned pix, uint32_t c)    = 0;
+    virtual void     setPixels(unsigned pix, const uint32_t *c, size_t len) { for (size_t i = 0; i < len; i++) setPixelColor(pix + i, c[i]); } // sets len consecutive pixels
     virtual void     setBrightness(uint8_t b)                   { _bri = b; };
     virtual void     setColorOrder(uint8_t co)                  {}
     virtual uint32_t getPixelColor(unsigned pix) const          { return 0; }
@@ -146,7 +151,7 @@ class Bus {
     inline  bool     is16bit() const                            { return is16bit(_type); }
     inline  bool     mustRefresh() const                        { return mustRefresh(_type); }
     inline  void     setReversed(bool reversed)                 { _reversed = reversed; }
-    inline  void     setStart(uint16_t start)                   { _start = start; }
+    inline  void     setStart(uint16_t start)                   { _start = start; } // BusManager::rebuildRouting() must be called afterwards
     inline  void     setAutoWhiteMode(uint8_t m)                { if (m < 5) _autoWhiteMode = m; }
     inline  uint8_t  getAutoWhiteMode() const                   { return _autoWhiteMode; }
     inline  size_t   getNumberOfChannels() const                { return hasWhite() + 3*hasRGB() + hasCCT(); }
@@ -239,8 +244,10 @@ class BusDigital : public Bus {
     void show() override;
     bool canShow() const override;
     void setStatusPixel(uint32_t c) override;
-    [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override { setPixels(pix, &c, 1); }
+    [[gnu::hot]] void setPixels(unsigned pix, const uint32_t *c, size_t len) override;
     void setColorOrder(uint8_t colorOrder) override;
+    void resolveColorOrder(); // splits bus into color order runs, call whenever ColorOrderMap changes (see BusManager::updateColorOrderMap())
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     uint8_t  getColorOrder() const override  { return _colorOrder; }
     size_t   getPins(uint8_t* pinArray = nullptr) const override;
@@ -270,6 +277,29 @@ class BusDigital : public Bus {
     uint32_t _colorSum; // total color value for the bus, updated in setPixelColor(), used to estimate current
     void    *_busPtr;
 
+    typedef struct {
+      uint16_t start;       // first pixel of the run (as sent to NeoPixelBus, including skipped pixels)
+      uint8_t  colorOrder;
+    } co_run_t;
+    std::vector<co_run_t> _coRuns; // ColorOrderMap resolved for this bus, empty if all pixels use _colorOrder
+
+    // color order of pixel p, r is the index of the run used last (pixels are mostly accessed in order)
+    inline uint8_t colorOrderAt(unsigned p, size_t &r) const {
+      while (r + 1 < _coRuns.size() && p >= _coRuns[r+1].start) r++;
+      while (p < _coRuns[r].start) r--;
+      return _coRuns[r].colorOrder;
+    }
+    // color order of pixel p for random access (binary search for the last run starting at or before p, first run starts at 0)
+    inline uint8_t colorOrderAt(unsigned p) const {
+      size_t lo = 0, hi = _coRuns.size();
+      while (hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+        if (p >= _coRuns[mid].start) lo = mid;
+        else                         hi = mid;
+      }
+      return _coRuns[lo].colorOrder;
+    }
+
     static uint16_t _milliAmpsTotal; // is overwitten/recalculated on each show()
 
     inline uint32_t restoreColorLossy(uint32_t c, uint8_t restoreBri) const {
@@ -339,7 +369,8 @@ class BusNetwork : public Bus {
     ~BusNetwork() { cleanup(); }
 
     bool canShow() const override  { return !_broadcastLock; } // this should be a return value from UDP routine if it is still sending data out
-    [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override { setPixels(pix, &c, 1); }
+    [[gnu::hot]] void setPixels(unsigned pix, const uint32_t *c, size_t len) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     size_t getPins(uint8_t* pinArray = nullptr) const override;
     size_t getBusSize() const override  { return sizeof(BusNetwork) + (isOk() ? _len * _UDPchannels : 0); }
@@ -465,11 +496,13 @@ namespace BusManager {
   //do not call this method from system context (network callback)
   void removeAll();
   int  add(const BusConfig &bc);
+  void rebuildRouting(); // called by add() and removeAll(), call after changing bus start or length
 
   void on();
   void off();
 
   [[gnu::hot]] void     setPixelColor(unsigned pix, uint32_t c);
+  [[gnu::hot]] void     setPixels(unsigned pix, const uint32_t *c, size_t len); // sets len consecutive pixels (may span multiple buses)
   [[gnu::hot]] uint32_t getPixelColor(unsigned pix);
   void        show();
   bool        canAllShow();
@@ -490,5 +523,6 @@ namespace BusManager {
   }
   String         getLEDTypesJSONString();
   ColorOrderMap& getColorOrderMap();
+  void           updateColorOrderMap(); // re-resolves color order runs of digital buses if ColorOrderMap changed (call from loop(), not while buses output)
 };
 #endif
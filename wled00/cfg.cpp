@@ -600,6 +600,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   JsonObject if_live_dmx = if_live["dmx"];
   CJSON(e131Universe, if_live_dmx[F("uni")]);
   CJSON(e131SkipOutOfSequence, if_live_dmx[F("seqskip")]);
+  CJSON(e131MinFrameMs, if_live_dmx[F("minfrm")]);
   CJSON(DMXAddress, if_live_dmx[F("addr")]);
   if (!DMXAddress || DMXAddress > 510) DMXAddress = 1;
   CJSON(DMXSegmentSpacing, if_live_dmx[F("dss")]);
@@ -610,6 +611,9 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
 
   tdd = if_live[F("timeout")] | -1;
   if (tdd >= 0) realtimeTimeoutMs = tdd * 100;
+  CJSON(udpRxBudgetUs, if_live[F("rxbudget")]);
+  CJSON(udpFrameLeds, if_live[F("frameleds")]);
+  CJSON(udpFrameTimeoutMs, if_live[F("framewait")]);
 
   #ifdef WLED_ENABLE_DMX_INPUT
     CJSON(dmxInputTransmitPin, if_live_dmx[F("inputRxPin")]);
@@ -1129,6 +1133,7 @@ void serializeConfig(JsonObject root) {
   JsonObject if_live_dmx = if_live.createNestedObject("dmx");
   if_live_dmx[F("uni")] = e131Universe;
   if_live_dmx[F("seqskip")] = e131SkipOutOfSequence;
+  if_live_dmx[F("minfrm")] = e131MinFrameMs;
   if_live_dmx[F("e131prio")] = e131Priority;
   if_live_dmx[F("addr")] = DMXAddress;
   if_live_dmx[F("dss")] = DMXSegmentSpacing;
@@ -1141,6 +1146,9 @@ void serializeConfig(JsonObject root) {
   #endif
 
   if_live[F("timeout")] = realtimeTimeoutMs / 100;
+  if_live[F("rxbudget")] = udpRxBudgetUs;
+  if_live[F("frameleds")] = udpFrameLeds;
+  if_live[F("framewait")] = udpFrameTimeoutMs;
   if_live[F("maxbri")] = arlsForceMaxBri;
   if_live[F("no-gc")] = arlsDisableGammaCorrection;
   if_live[F("offset")] = arlsOffset;
@@ -139,6 +139,23 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 
 #define WLED_MAX_PANELS 18                      // must not be more than 32
 
+// WLED_ENABLE_PARALLEL_RENDER: segments due in a frame are rendered concurrently by loop() and WLED_RENDER_TASKS render tasks
+// (needs a dual core ESP32 or the host build, each segment has its own draw context, see Segment::beginDraw())
+#if defined(WLED_ENABLE_PARALLEL_RENDER) && (!defined(ARDUINO_ARCH_ESP32) || defined(CONFIG_FREERTOS_UNICORE) || defined(CONFIG_IDF_TARGET_ESP32C3) || defined(CONFIG_IDF_TARGET_ESP32S2))
+  #undef WLED_ENABLE_PARALLEL_RENDER
+#endif
+#ifdef WLED_ENABLE_PARALLEL_RENDER
+  #ifndef WLED_RENDER_TASKS
+    #define WLED_RENDER_TASKS 1                 // one render task on the second core
+  #endif
+  #if defined(WLED_ENABLE_DETERMINISTIC_RNG) && !defined(WLED_HOST_BUILD)
+    #error "WLED_ENABLE_DETERMINISTIC_RNG needs a per task FastLED random16() state, not available with WLED_ENABLE_PARALLEL_RENDER."
+  #endif
+  #define WLED_RENDER_LOCAL thread_local        // state touched by effect functions is kept per render task
+#else
+  #define WLED_RENDER_LOCAL
+#endif
+
 //Usermod IDs
 #define USERMOD_ID_RESERVED               0     //Unused. Might indicate no usermod present
 #define USERMOD_ID_UNSPECIFIED            1     //Default value for a general user mod that does not specify a custom ID
@@ -3,6 +3,15 @@
 #define MAX_3_CH_LEDS_PER_UNIVERSE 170
 #define MAX_4_CH_LEDS_PER_UNIVERSE 128
 #define MAX_CHANNELS_PER_UNIVERSE 512
+#define DMX_SYNC_TIMEOUT 2500 // ms without sync packets after which data is output unsynchronized again (E1.31: network data loss timeout)
+
+// E1.31/Art-Net frame tracking, bit n of the masks stands for universe e131Universe+n
+static uint32_t e131UniversesReceived = 0; // universes received since the last output
+static uint32_t e131UniversesExpected = 0; // universes that made up the last frame
+static unsigned long e131FrameStart = 0;   // arrival of the first universe of the pending frame
+static unsigned long e131LastSync = 0;     // last E1.31 Universe Sync or ArtSync packet, output waits for sync packets while recent
+static uint16_t e131SyncAddress = 0;       // synchronization universe announced by E1.31 data packets (0 = none)
+static bool e131SyncPending = false;       // sync packet received, output accumulated data now
 
 /*
  * E1.31 handler
@@ -38,11 +47,7 @@ void handleDDPPacket(e131_packet_t* p) {
   if (realtimeMode != REALTIME_MODE_DDP) ddpSeenPush = false; // just starting, no push yet
   realtimeLock(realtimeTimeoutMs, REALTIME_MODE_DDP);
 
-  if (!realtimeOverride) {
-    for (unsigned i = start; i < stop; i++, c += ddpChannelsPerLed) {
-      setRealtimePixel(i, data[c], data[c+1], data[c+2], ddpChannelsPerLed >3 ? data[c+3] : 0);
-    }
-  }
+  if (!realtimeOverride) setRealtimePixels(start, data + c, stop - start, ddpChannelsPerLed);
 
   bool push = p->flags & DDP_PUSH_FLAG;
   ddpSeenPush |= push;
@@ -53,6 +58,37 @@ void handleDDPPacket(e131_packet_t* p) {
   }
 }
 
+static void trackUniverse(unsigned index) {
+  const uint32_t bit = 1UL << index;
+  if (e131UniversesReceived & bit) e131UniversesReceived = 0; // universe repeated before output: next frame started, packets were lost
+  if (!e131UniversesReceived) e131FrameStart = millis();
+  e131UniversesReceived |= bit;
+}
+
+static void handleDMXSync(byte protocol, uint16_t address) {
+  // E1.31 sync packets only apply to data packets announcing the same synchronization universe
+  if (protocol == P_E131 && (!e131SyncAddress || address != e131SyncAddress)) return;
+  e131LastSync = millis();
+  if (e131NewData) e131SyncPending = true;
+}
+
+// decides whether accumulated E1.31/Art-Net/DDP data is output now, called by handleNotifications() while e131NewData is set
+bool isE131FrameDue() {
+  const unsigned long now = millis();
+  bool due;
+  if (e131SyncPending) due = true;                                                   // controller signalled frame completion
+  else if (e131LastSync && now - e131LastSync < DMX_SYNC_TIMEOUT) due = false;       // synchronized: wait for next sync packet
+  else if (now - strip.getLastShow() < e131MinFrameMs) due = false;                  // max. frame rate
+  else due = (e131UniversesReceived & e131UniversesExpected) == e131UniversesExpected // all universes of the last frame arrived
+          || now - e131FrameStart > udpFrameTimeoutMs;                               // give up waiting for lost universes
+  if (due) {
+    e131SyncPending = false;
+    if (e131UniversesReceived) e131UniversesExpected = e131UniversesReceived;
+    e131UniversesReceived = 0;
+  }
+  return due;
+}
+
 //E1.31 and Art-Net protocol support
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
 
@@ -66,12 +102,20 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       handleArtnetPollReply(clientIP);
       return;
     }
+    if (p->art_opcode == ARTNET_OPCODE_OPSYNC) {
+      handleDMXSync(protocol, 0);
+      return;
+    }
     uni = p->art_universe;
     dmxChannels = htons(p->art_length);
     e131_data = p->art_data;
     seq = p->art_sequence_number;
     mde = REALTIME_MODE_ARTNET;
   } else if (protocol == P_E131) {
+    if (htonl(p->root_vector) == E131_VECTOR_ROOT_EXTENDED) { // Universe Synchronization (E1.31: 6.3)
+      handleDMXSync(protocol, htons(p->sync_address));
+      return;
+    }
     // Ignore PREVIEW data (E1.31: 6.2.6)
     if ((p->options & 0x80) != 0) return;
     dmxChannels = htons(p->property_value_count) - 1;
@@ -113,6 +157,9 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
     }
   e131LastSequenceNumber[previousUniverses] = seq;
 
+  if (protocol == P_E131) e131SyncAddress = htons(p->reserved);
+  trackUniverse(previousUniverses);
+
   // update status info
   realtimeIP = clientIP;
 
@@ -313,10 +360,7 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
           }
         }
 
-        for (unsigned i = previousLeds; i < ledsTotal; i++) {
-          setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], is4Chan ? e131_data[dmxOffset+3] : 0);
-          dmxOffset += dmxChannelsPerLed;
-        }
+        if (ledsTotal > previousLeds) setRealtimePixels(previousLeds, e131_data + dmxOffset, ledsTotal - previousLeds, dmxChannelsPerLed);
         break;
       }
     default:
@@ -83,6 +83,7 @@ void handleDMXInput();
 
 //e131.cpp
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol);
+bool isE131FrameDue();
 void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8_t mde, uint8_t previousUniverses);
 void handleArtnetPollReply(IPAddress ipAddress);
 void prepareArtnetPollReply(ArtPollReply* reply);
@@ -214,6 +215,32 @@ int16_t loadPlaylist(JsonObject playlistObject, byte presetId = 0);
 void handlePlaylist();
 void serializePlaylist(JsonObject obj);
 
+//profiler.cpp
+// main loop handlers timed by the loop profiler (see WLED::loop())
+enum loop_handler_t : uint8_t {
+  PROF_OTHER = 0,     // everything not listed below (time, connection, IO, config saving, ...)
+  PROF_NOTIFICATIONS,
+  PROF_TRANSITIONS,
+  PROF_USERMODS,
+  PROF_PRESETS,
+  PROF_PLAYLIST,
+  PROF_STRIP,
+  PROF_WS,
+  PROF_MQTT,
+  PROF_HUE,
+  PROF_IR,
+  PROF_HANDLERS,      // number of handlers
+  PROF_LOOP = PROF_HANDLERS  // whole loop iteration (statistics only)
+};
+typedef struct {
+  uint32_t avg, p50, p90, p99, max; // in us, over last complete window
+} loop_profile_t;
+void profileLoopStart();
+void profileLap(uint8_t handler);   // attributes time since previous lap to handler
+void profileLoopEnd();
+const loop_profile_t &getLoopProfile(uint8_t handler);
+void serializeLoopProfile(JsonObject root);
+
 //presets.cpp
 const char *getPresetsFileName(bool persistent = true);
 bool presetNeedsSaving();
@@ -244,6 +271,7 @@ void realtimeLock(uint32_t timeoutMs, byte md = REALTIME_MODE_GENERIC);
 void exitRealtime();
 void handleNotifications();
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
+void setRealtimePixels(unsigned start, const uint8_t *data, unsigned count, unsigned channels);
 void refreshNodeList();
 void sendSysInfoUDP();
 #ifndef WLED_DISABLE_ESPNOW
@@ -302,7 +330,7 @@ class Usermod {
     virtual ~Usermod() { if (um_data) delete um_data; }
     virtual void setup() = 0; // pure virtual, has to be overriden
     virtual void loop() = 0;  // pure virtual, has to be overriden
-    virtual void handleOverlayDraw() {}                                      // called after all effects have been processed, just before strip.show()
+    virtual void handleOverlayDraw();                                        // called after all effects have been processed, just before strip.show()
     virtual bool handleButton(uint8_t b) { return false; }                   // button overrides are possible here
     virtual bool getUMData(um_data_t **data) { if (data) *data = nullptr; return false; }; // usermod data exchange [see examples for audio effects]
     virtual void connected() {}                                              // called when WiFi is (re)connected
@@ -338,6 +366,7 @@ class Usermod {
 namespace UsermodManager {
   void loop();
   void handleOverlayDraw();
+  bool hasOverlay();            // true if a usermod implements handleOverlayDraw() (its changes are not tracked by segments)
   bool handleButton(uint8_t b);
   bool getUMData(um_data_t **um_data, uint8_t mod_id = USERMOD_ID_RESERVED); // USERMOD_ID_RESERVED will poll all usermods
   void setup();
@@ -377,6 +406,20 @@ void userLoop();
 #include "soc/wdev_reg.h"
 #define HW_RND_REGISTER REG_READ(WDEV_RND_REG)
 #endif
+#ifdef WLED_ENABLE_DETERMINISTIC_RNG
+// deterministic mode: hw_random*() draw from a seedable PRNG instead of the hardware RNG
+// each segment has its own stream that is swapped in while its effect runs (see WS2812FX::service())
+// so a given seed and timebase reproduce bit-identical frames
+extern WLED_RENDER_LOCAL uint32_t hwRndState;
+inline uint32_t hw_rnd_next() {
+  uint32_t z = (hwRndState += 0x9E3779B9); // Weyl sequence, mixed so that every bit is usable (hw_random8/16 use the low bits)
+  z = (z ^ (z >> 16)) * 0x7FEB352D;
+  z = (z ^ (z >> 15)) * 0x846CA68B;
+  return z ^ (z >> 16);
+}
+#undef HW_RND_REGISTER
+#define HW_RND_REGISTER hw_rnd_next()
+#endif
 #define inoise8 perlin8   // fastled legacy alias
 #define inoise16 perlin16 // fastled legacy alias
 #define hex2int(a) (((a)>='0' && (a)<='9') ? (a)-'0' : ((a)>='A' && (a)<='F') ? (a)-'A'+10 : ((a)>='a' && (a)<='f') ? (a)-'a'+10 : 0)
@@ -440,17 +483,13 @@ extern "C" {
   void *d_malloc(size_t);
   void *d_calloc(size_t, size_t);
   void *d_realloc_malloc(void *ptr, size_t size);
-  #ifndef ESP8266
-  inline void d_free(void *ptr) { heap_caps_free(ptr); }
-  #else
-  inline void d_free(void *ptr) { free(ptr); }
-  #endif
+  void d_free(void *ptr);
   #if defined(BOARD_HAS_PSRAM)
   // prefer PSRAM in p_xalloc functions, DRAM as fallback
   void *p_malloc(size_t);
   void *p_calloc(size_t, size_t);
   void *p_realloc_malloc(void *ptr, size_t size);
-  inline void p_free(void *ptr) { heap_caps_free(ptr); }
+  inline void p_free(void *ptr) { d_free(ptr); }
   #else
   #define p_malloc d_malloc
   #define p_calloc d_calloc
@@ -471,8 +510,35 @@ inline size_t getContiguousFreeHeap() { return ESP.getMaxFreeBlockSize(); } // r
 #define BFRALLOC_PREFER_PSRAM    (1 << 3) // prefer PSRAM over DRAM
 #define BFRALLOC_ENFORCE_PSRAM   (1 << 4) // use PSRAM if available, otherwise uses DRAM
 #define BFRALLOC_CLEAR           (1 << 5) // clear allocated buffer after allocation
+#define BFRALLOC_TAG(t)          ((uint32_t)(t) << 24) // account allocation to telemetry tag t (ALLOC_TAG_x)
 void *allocate_buffer(size_t size, uint32_t type);
 
+// allocation telemetry: all buffers allocated with d_xalloc, p_xalloc and allocate_buffer() are accounted per memory region and tag
+#define ALLOC_TAG_OTHER       0
+#define ALLOC_TAG_SEGPIXELS   1 // segment pixel buffers
+#define ALLOC_TAG_SEGDATA     2 // effect data (Segment::allocateData())
+#define ALLOC_TAG_SEGNAME     3 // segment names
+#define ALLOC_TAG_TRANSITION  4 // segment copies used for effect transitions
+#define ALLOC_TAG_FRAME       5 // strip frame buffer
+#define ALLOC_TAG_CCT         6 // per pixel CCT buffer
+#define ALLOC_TAG_LEDMAP      7 // ledmap & gap table
+#define ALLOC_TAG_SEGMAP      8 // segment 1D to 2D expansion maps (Segment::updateMapping1D2D())
+#define ALLOC_TAG_PALETTE     9 // segment palette lookup tables (Segment::paletteLookup())
+#define ALLOC_TAGS           10
+#define ALLOC_REGION_DRAM     0
+#define ALLOC_REGION_PSRAM    1
+#define ALLOC_REGION_IRAM     2 // 32bit accessible DRAM (ESP32) or RTC RAM (S2, S3, C3)
+#define ALLOC_REGIONS         3
+typedef struct {
+  uint32_t live;   // bytes currently allocated
+  uint32_t peak;   // max. bytes allocated at once
+  uint32_t allocs; // number of allocations
+  uint32_t fails;  // number of failed allocations
+} alloc_stats_t;
+void *tagAllocation(void *ptr, uint8_t tag); // (re)assigns allocated buffer to tag, returns ptr
+void snapshotAllocations();                  // records live bytes per tag (called before segments are purged on low heap)
+void serializeAllocations(JsonObject root);
+
 void handleBootLoop();   // detect and handle bootloops
 #ifndef ESP8266
 void bootloopCheckOTA(); // swap boot image if bootloop is detected instead of restoring config
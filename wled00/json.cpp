@@ -412,6 +412,11 @@ bool deserializeState(JsonObject root, byte callMode, byte presetId)
   tr = root[F("tb")] | -1;
   if (tr >= 0) strip.timebase = (unsigned long)tr - millis();
 
+  #ifdef WLED_ENABLE_DETERMINISTIC_RNG
+  JsonVariant seed = root[F("seed")];
+  if (seed.is<uint32_t>() && seed.as<uint32_t>() != strip.getRandomSeed()) strip.setRandomSeed(seed);
+  #endif
+
   JsonObject nl       = root["nl"];
   if (!nl.isNull()) stateChanged = true;
   nightlightActive    = getBoolVal(nl["on"], nightlightActive);
@@ -646,6 +651,9 @@ void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segme
     root["ps"] = (currentPreset > 0) ? currentPreset : -1;
     root[F("pl")] = currentPlaylist;
     root[F("ledmap")] = currentLedmap;
+    #ifdef WLED_ENABLE_DETERMINISTIC_RNG
+    root[F("seed")] = strip.getRandomSeed();
+    #endif
 
     UsermodManager::addToJsonState(root);
 
@@ -689,6 +697,47 @@ void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segme
   }
 }
 
+// render pipeline timing in us: [min, avg, max, p99] over the last TIMING_WINDOW samples
+static void serializeTiming(JsonArray arr, const TimingStats &t)
+{
+  arr.add(t.min);
+  arr.add(t.avg);
+  arr.add(t.max);
+  arr.add(t.p99);
+}
+
+// render pipeline timing and frame scheduler statistics for /json/prof (kept out of /json/info which the UI polls)
+static void serializeRenderTiming(JsonObject root)
+{
+  JsonObject timing = root.createNestedObject(F("timing"));
+  serializeTiming(timing.createNestedArray(F("paint")), strip.getPaintTiming());
+  serializeTiming(timing.createNestedArray(F("show")), strip.getBusShowTiming());
+  JsonArray segTiming = timing.createNestedArray("seg");
+  size_t nSegs = strip.getSegmentsNum();
+  for (size_t s = 0; s < nSegs; s++) {
+    const segment_timing_t *t = strip.getSegmentTiming(s);
+    if (!t || !strip.getSegment(s).isActive()) continue;
+    JsonObject st = segTiming.createNestedObject();
+    st["id"] = s;
+    serializeTiming(st.createNestedArray("fx"), t->fx);
+    serializeTiming(st.createNestedArray(F("old")), t->old);
+    serializeTiming(st.createNestedArray(F("blend")), t->blend);
+  }
+
+  // frame scheduler: target and achieved FPS, dropped frames and start jitter (us) over the last SCHED_WINDOW_MS
+  const FrameStats &fs = strip.getFrameStats();
+  JsonObject sched = root.createNestedObject(F("sched"));
+  sched[F("target")] = strip.getTargetFps();
+  sched["fps"]  = fs.fps100 / 100.0f;
+  sched["n"]    = fs.frames;
+  sched[F("drop")] = fs.dropped;
+  JsonArray jitter = sched.createNestedArray(F("jit"));
+  jitter.add(fs.jitterAvg);
+  jitter.add(fs.jitterMax);
+  JsonArray hist = sched.createNestedArray(F("hist")); // bucket b: [2^b, 2^(b+1)) us
+  for (unsigned b = 0; b < SCHED_BUCKETS; b++) hist.add(fs.hist[b]);
+}
+
 void serializeInfo(JsonObject root)
 {
   root[F("ver")] = versionString;
@@ -700,6 +749,7 @@ void serializeInfo(JsonObject root)
   leds[F("count")] = strip.getLengthTotal();
   leds[F("pwr")] = BusManager::currentMilliamps();
   leds["fps"] = strip.getFps();
+  leds[F("idle")] = strip.getIdleFrames(); // frames not rendered as the frame was static
   leds[F("maxpwr")] = BusManager::currentMilliamps()>0 ? BusManager::ablMilliampsMax() : 0;
   leds[F("maxseg")] = WS2812FX::getMaxSegments();
   //leds[F("actseg")] = strip.getActiveSegmentsNum();
@@ -747,6 +797,10 @@ void serializeInfo(JsonObject root)
   root[F("simplifiedui")] = simplifiedUI;
   root["live"] = (bool)realtimeMode;
   root[F("liveseg")] = useMainSegmentOnly ? strip.getMainSegmentId() : -1;  // if using main segment only for live
+  JsonArray udprx = root.createNestedArray(F("udprx")); // UDP packets received, dropped, loop passes out of budget
+  udprx.add(udpRxPackets);
+  udprx.add(udpRxDropped);
+  udprx.add(udpRxLate);
 
   switch (realtimeMode) {
     case REALTIME_MODE_INACTIVE: root["lm"] = ""; break;
@@ -833,6 +887,7 @@ void serializeInfo(JsonObject root)
   #if defined(BOARD_HAS_PSRAM)
   root[F("psram")] = ESP.getFreePsram();
   #endif
+  serializeAllocations(root.createNestedObject(F("alloc")));
   root[F("uptime")] = millis()/1000 + rolloverMillis*4294967;
 
   char time[32];
@@ -1094,7 +1149,7 @@ class LockedJsonResponse: public AsyncJsonResponse {
 void serveJson(AsyncWebServerRequest* request)
 {
   enum class json_target {
-    all, state, info, state_info, nodes, effects, palettes, fxdata, networks, config
+    all, state, info, state_info, nodes, effects, palettes, fxdata, networks, config, profile
   };
   json_target subJson = json_target::all;
 
@@ -1108,6 +1163,7 @@ void serveJson(AsyncWebServerRequest* request)
   else if (url.indexOf(F("fxda"))  > 0) subJson = json_target::fxdata;
   else if (url.indexOf(F("net"))   > 0) subJson = json_target::networks;
   else if (url.indexOf(F("cfg"))   > 0) subJson = json_target::config;
+  else if (url.indexOf(F("prof"))  > 0) subJson = json_target::profile;
   #ifdef WLED_ENABLE_JSONLIVE
   else if (url.indexOf("live")     > 0) {
     serveLiveLeds(request);
@@ -1151,6 +1207,10 @@ void serveJson(AsyncWebServerRequest* request)
       serializeNetworks(lDoc); break;
     case json_target::config:
       serializeConfig(lDoc); break;
+    case json_target::profile:
+      serializeLoopProfile(lDoc);
+      serializeRenderTiming(lDoc);
+      break;
     case json_target::state_info:
     case json_target::all:
       JsonObject state = lDoc.createNestedObject("state");
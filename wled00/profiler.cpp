@@ -0,0 +1,144 @@
+#include "wled.h"
+
+/*
+ * Main loop profiler
+ *
+ * Every loop iteration is split into laps, each lap is attributed to a handler (profileLap()).
+ * Per handler a histogram with power of 2 buckets is collected over a window of PROF_WINDOW_MS
+ * from which avg/p50/p90/p99/max are calculated at the end of the window (percentiles are
+ * upper bounds of the bucket, so at most 2x too high).
+ * Iterations slower than PROF_SLOW_US are stored with their per-handler breakdown in a ring buffer.
+ * Cost is one micros() call per lap and ~1.3kB of RAM.
+ */
+
+#define PROF_BUCKETS    20      // bucket b holds [2^b, 2^(b+1)) us (bucket 0 also holds 0), last bucket everything above 0.5s
+#define PROF_WINDOW_MS  10000   // statistics window
+#define PROF_SLOW_US    25000   // iterations taking longer are recorded in history (one frame at 40 FPS)
+#define PROF_HISTORY    8       // number of slow iterations kept
+
+typedef struct {
+  uint16_t hist[PROF_BUCKETS];
+  uint32_t sum;
+  uint32_t max;
+} prof_acc_t;
+
+typedef struct {
+  uint32_t time;                // millis() at end of iteration
+  uint32_t total;               // us
+  uint32_t lap[PROF_HANDLERS];  // us
+} prof_slow_t;
+
+static const char prof_names[PROF_HANDLERS][12] PROGMEM = {
+  "other", "notify", "transitions", "usermods", "presets", "playlist", "strip", "ws", "mqtt", "hue", "ir"
+};
+
+static prof_acc_t     acc[PROF_HANDLERS+1];
+static loop_profile_t results[PROF_HANDLERS+1];
+static prof_slow_t    slow[PROF_HISTORY];
+static uint8_t        slowNext = 0;     // next history entry to overwrite
+static uint8_t        slowCount = 0;
+static uint16_t       visited = 0;      // handlers that ran in current iteration
+static uint16_t       windowIterations = 0;
+static uint16_t       lastIterations = 0;
+static uint32_t       windowStart = 0;
+static unsigned long  loopStart = 0, lapStart = 0;
+static uint32_t       lap[PROF_HANDLERS];
+
+static void profileAdd(prof_acc_t &a, uint32_t us) {
+  unsigned b = us ? 31 - __builtin_clz(us) : 0;
+  if (b >= PROF_BUCKETS) b = PROF_BUCKETS - 1;
+  if (a.hist[b] < UINT16_MAX) a.hist[b]++;
+  a.sum += us;
+  if (us > a.max) a.max = us;
+}
+
+// value below which the given permille of samples lie (upper bound of the bucket)
+static uint32_t profilePercentile(const prof_acc_t &a, unsigned n, unsigned permille) {
+  unsigned target = (n * permille + 999) / 1000;
+  unsigned cnt = 0;
+  for (unsigned b = 0; b < PROF_BUCKETS; b++) {
+    cnt += a.hist[b];
+    if (cnt >= target) return min((2U << b) - 1, a.max);
+  }
+  return a.max;
+}
+
+static void profileWindowEnd() {
+  for (unsigned h = 0; h <= PROF_HANDLERS; h++) {
+    unsigned n = 0;
+    for (unsigned b = 0; b < PROF_BUCKETS; b++) n += acc[h].hist[b];
+    if (n) {
+      results[h].avg = acc[h].sum / n;
+      results[h].p50 = profilePercentile(acc[h], n, 500);
+      results[h].p90 = profilePercentile(acc[h], n, 900);
+      results[h].p99 = profilePercentile(acc[h], n, 990);
+      results[h].max = acc[h].max;
+    } else {
+      memset(&results[h], 0, sizeof(loop_profile_t));
+    }
+  }
+  memset(acc, 0, sizeof(acc));
+  lastIterations = windowIterations;
+  windowIterations = 0;
+  windowStart = millis();
+}
+
+void profileLoopStart() {
+  loopStart = lapStart = micros();
+  memset(lap, 0, sizeof(lap));
+  visited = 0;
+}
+
+void profileLap(uint8_t handler) {
+  unsigned long now = micros();
+  lap[handler] += now - lapStart;
+  visited |= 1U << handler;
+  lapStart = now;
+}
+
+void profileLoopEnd() {
+  profileLap(PROF_OTHER);
+  uint32_t total = lapStart - loopStart;
+  for (unsigned h = 0; h < PROF_HANDLERS; h++) if (visited & (1U << h)) profileAdd(acc[h], lap[h]); // skip handlers that did not run
+  profileAdd(acc[PROF_LOOP], total);
+  if (total > PROF_SLOW_US) {
+    slow[slowNext].time  = millis();
+    slow[slowNext].total = total;
+    memcpy(slow[slowNext].lap, lap, sizeof(lap));
+    slowNext = (slowNext + 1) % PROF_HISTORY;
+    if (slowCount < PROF_HISTORY) slowCount++;
+  }
+  if (++windowIterations == UINT16_MAX || millis() - windowStart >= PROF_WINDOW_MS) profileWindowEnd();
+}
+
+const loop_profile_t &getLoopProfile(uint8_t handler) {
+  return results[handler > PROF_LOOP ? PROF_LOOP : handler];
+}
+
+static void serializeProfile(JsonArray arr, const loop_profile_t &r) {
+  arr.add(r.avg);
+  arr.add(r.p50);
+  arr.add(r.p90);
+  arr.add(r.p99);
+  arr.add(r.max);
+}
+
+// /json/prof: {"win":ms,"n":iterations,"loop":[avg,p50,p90,p99,max],"h":{"strip":[...],...},"thr":us,"slow":[{"t":millis,"us":total,"h":{...}},...]}
+void serializeLoopProfile(JsonObject root) {
+  root[F("win")] = PROF_WINDOW_MS;
+  root["n"] = lastIterations;
+  serializeProfile(root.createNestedArray(F("loop")), results[PROF_LOOP]);
+  JsonObject handlers = root.createNestedObject("h");
+  for (unsigned h = 0; h < PROF_HANDLERS; h++) serializeProfile(handlers.createNestedArray(FPSTR(prof_names[h])), results[h]);
+
+  root[F("thr")] = PROF_SLOW_US;
+  JsonArray history = root.createNestedArray(F("slow"));
+  for (unsigned i = 0; i < slowCount; i++) {
+    const prof_slow_t &e = slow[(slowNext + PROF_HISTORY - 1 - i) % PROF_HISTORY]; // newest first
+    JsonObject entry = history.createNestedObject();
+    entry["t"]  = e.time;
+    entry["us"] = e.total;
+    JsonObject laps = entry.createNestedObject("h");
+    for (unsigned h = 0; h < PROF_HANDLERS; h++) if (e.lap[h]) laps[FPSTR(prof_names[h])] = e.lap[h];
+  }
+}
@@ -59,6 +59,11 @@ typedef struct ip_addr ip4_addr_t;
 #define ARTNET_OPCODE_OPDMX 0x5000
 #define ARTNET_OPCODE_OPPOLL 0x2000
 #define ARTNET_OPCODE_OPPOLLREPLY 0x2100
+#define ARTNET_OPCODE_OPSYNC 0x5200
+
+// E1.31 root/frame layer vectors of the synchronization packet (E1.31-2016: 6.3)
+#define E131_VECTOR_ROOT_EXTENDED 0x00000008
+#define E131_VECTOR_EXTENDED_SYNCHRONIZATION 0x00000001
 
 #define P_E131   0
 #define P_ARTNET 1
@@ -105,7 +110,7 @@ typedef union {
       uint32_t frame_vector;
       uint8_t  source_name[64];
       uint8_t  priority;
-      uint16_t reserved;
+      uint16_t reserved;        // synchronization address (E1.31-2016), 0 = unsynchronized
       uint8_t  sequence_number;
       uint8_t  options;
       uint16_t universe;
@@ -120,6 +125,15 @@ typedef union {
       uint8_t  property_values[513];
     } __attribute__((packed));
 	
+  struct { //E1.31 synchronization packet (root layer as above)
+      uint8_t  sync_root[38];
+      uint16_t sync_flength;
+      uint32_t sync_vector;
+      uint8_t  sync_sequence_number;
+      uint16_t sync_address;
+      uint16_t sync_reserved;
+  } __attribute__((packed));
+
 	struct { //Art-Net packet
     uint8_t  art_id[8];
     uint16_t art_opcode;
@@ -465,16 +465,89 @@ void sendTPM2Ack() {
 }
 
 
-void handleNotifications()
+/*
+ * UDP realtime frame assembly (DRGB/DRGBW/DNRGB/DNRGBW/Hyperion)
+ * LED ranges of the current frame are collected and the frame is shown once when it is complete,
+ * when a packet overlaps data already received (start of the next frame), on an explicit sync packet
+ * (DNRGB/DNRGBW header without LED data) or after udpFrameTimeoutMs
+ */
+#define RT_FRAME_RANGES 8
+
+static struct {
+  uint16_t start[RT_FRAME_RANGES]; // sorted, disjoint LED ranges [start, end) received for the pending frame
+  uint16_t end[RT_FRAME_RANGES];
+  uint8_t  ranges;                 // number of ranges, 0 = no frame pending
+  uint16_t learned;                // highest LED of the last frame, expected length if udpFrameLeds is 0
+  unsigned long since;             // arrival of the first packet of the pending frame
+} rtFrame;
+
+static void showRealtimeFrame()
 {
-  IPAddress localIP;
+  if (rtFrame.ranges) rtFrame.learned = rtFrame.end[rtFrame.ranges-1];
+  rtFrame.ranges = 0;
+  if (useMainSegmentOnly) strip.trigger();
+  else                    strip.show();
+}
 
+// returns false if [s, e) overlaps a range already received or no more ranges can be tracked
+static bool addRealtimeRange(unsigned s, unsigned e)
+{
+  unsigned n = rtFrame.ranges;
+  for (unsigned i = 0; i < n; i++) if (rtFrame.start[i] < e && s < rtFrame.end[i]) return false;
+  if (n == RT_FRAME_RANGES) return false;
+  unsigned i = n;
+  for (; i > 0 && rtFrame.start[i-1] > s; i--) {
+    rtFrame.start[i] = rtFrame.start[i-1];
+    rtFrame.end[i]   = rtFrame.end[i-1];
+  }
+  rtFrame.start[i] = s;
+  rtFrame.end[i]   = e;
+  n++;
+  // merge adjacent ranges
+  unsigned j = 0;
+  for (unsigned k = 1; k < n; k++) {
+    if (rtFrame.start[k] == rtFrame.end[j]) rtFrame.end[j] = rtFrame.end[k];
+    else {
+      j++;
+      rtFrame.start[j] = rtFrame.start[k];
+      rtFrame.end[j]   = rtFrame.end[k];
+    }
+  }
+  rtFrame.ranges = j + 1;
+  return true;
+}
+
+// registers LEDs [start, start+count) of the frame, must be called before the pixels are written
+// (data overlapping the pending frame belongs to the next one, so the pending frame is shown first)
+static void beginRealtimeRange(unsigned start, unsigned count)
+{
+  if (!count) return;
+  unsigned end = min(start + count, 0xFFFFU);
+  if (rtFrame.ranges && addRealtimeRange(start, end)) return;
+  if (rtFrame.ranges) showRealtimeFrame(); // overlap: data belongs to the next frame
+  addRealtimeRange(start, end);
+  rtFrame.since = millis();
+}
+
+// shows the pending frame if all expected LEDs have been received
+static void endRealtimeRange()
+{
+  if (!rtFrame.ranges) return;
+  unsigned expected = udpFrameLeds ? udpFrameLeds : rtFrame.learned;
+  if (!expected) expected = useMainSegmentOnly ? strip.getMainSegment().length() : strip.getLengthTotal();
+  if (rtFrame.ranges == 1 && rtFrame.start[0] == 0 && rtFrame.end[0] >= expected) showRealtimeFrame();
+}
+
+static bool handleUdpPacket();
+
+void handleNotifications()
+{
   //send second notification if enabled
   if(udpConnected && (notificationCount < udpNumRetries) && ((millis()-notificationSentTime) > 250)){
     notify(notificationSentCallMode,true);
   }
 
-  if (e131NewData && millis() - strip.getLastShow() > 15)
+  if (e131NewData && isE131FrameDue())
   {
     e131NewData = false;
     if (useMainSegmentOnly) strip.trigger();
@@ -484,9 +557,35 @@ void handleNotifications()
   //unlock strip when realtime UDP times out
   if (realtimeMode && millis() > realtimeTimeout) exitRealtime();
 
+  //show incomplete UDP realtime frame (lost packets or sender uses fewer LEDs than expected)
+  if (rtFrame.ranges && millis() - rtFrame.since > udpFrameTimeoutMs) {
+    if ((realtimeMode == REALTIME_MODE_UDP || realtimeMode == REALTIME_MODE_HYPERION) && !realtimeOverride) showRealtimeFrame();
+    else {
+      rtFrame.ranges = 0;
+      rtFrame.learned = 0;
+    }
+  }
+
   //receive UDP notifications
   if (!udpConnected) return;
 
+  // drain all queued packets (at least one) until the time budget is used up, so multi-packet realtime frames
+  // are not spread over several loop passes and do not overflow the socket buffers
+  const unsigned long start = micros();
+  while (handleUdpPacket()) {
+    if (micros() - start < udpRxBudgetUs) continue;
+    // budget exhausted: sockets cannot be peeked without fetching the next packet, so one more is processed
+    // if there is one (counted as late), any further packets wait for the next loop pass
+    if (handleUdpPacket()) udpRxLate++;
+    break;
+  }
+}
+
+// reads and processes one pending UDP packet, returns false if there was none
+static bool handleUdpPacket()
+{
+  IPAddress localIP;
+
   bool isSupp = false;
   size_t packetSize = notifierUdp.parsePacket();
   if (!packetSize && udp2Connected) {
@@ -498,28 +597,33 @@ void handleNotifications()
   if (!packetSize && udpRgbConnected) {
     packetSize = rgbUdp.parsePacket();
     if (packetSize) {
-      if (!receiveDirect) return;
-      if (packetSize > UDP_IN_MAXSIZE || packetSize < 3) return;
+      udpRxPackets++;
+      if (!receiveDirect || packetSize > UDP_IN_MAXSIZE || packetSize < 3) {
+        udpRxDropped++;
+        return true;
+      }
       realtimeIP = rgbUdp.remoteIP();
       DEBUG_PRINTLN(rgbUdp.remoteIP());
       uint8_t lbuf[packetSize];
       rgbUdp.read(lbuf, packetSize);
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_HYPERION);
-      if (realtimeOverride) return;
-      unsigned totalLen = strip.getLengthTotal();
-      for (size_t i = 0, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++) {
-        setRealtimePixel(id, lbuf[i], lbuf[i+1], lbuf[i+2], 0);
-      }
-      if (useMainSegmentOnly) strip.trigger();
-      else                    strip.show();
-      return;
+      if (realtimeOverride) return true;
+      beginRealtimeRange(0, packetSize/3);
+      setRealtimePixels(0, lbuf, packetSize/3, 3);
+      endRealtimeRange();
+      return true;
     }
   }
 
   localIP = Network.localIP();
   //notifier and UDP realtime
-  if (!packetSize || packetSize > UDP_IN_MAXSIZE) return;
-  if (!isSupp && notifierUdp.remoteIP() == localIP) return; //don't process broadcasts we send ourselves
+  if (!packetSize) return false;
+  udpRxPackets++;
+  if (packetSize > UDP_IN_MAXSIZE) {
+    udpRxDropped++;
+    return true;
+  }
+  if (!isSupp && notifierUdp.remoteIP() == localIP) return true; //don't process broadcasts we send ourselves
 
   uint8_t udpIn[packetSize +1];
   unsigned len;
@@ -528,7 +632,7 @@ void handleNotifications()
 
   // WLED nodes info notifications
   if (isSupp && udpIn[0] == 255 && udpIn[1] == 1 && len >= 40) {
-    if (!nodeListEnabled || notifier2Udp.remoteIP() == localIP) return;
+    if (!nodeListEnabled || notifier2Udp.remoteIP() == localIP) return true;
 
     unsigned unit = udpIn[39];
     NodesMap::iterator it = Nodes.find(unit);
@@ -554,7 +658,7 @@ void handleNotifications()
           build |= udpIn[40+i]<<(8*i);
       it->second.build = build;
     }
-    return;
+    return true;
   }
 
   //wled notifier, ignore if realtime packets active
@@ -562,7 +666,7 @@ void handleNotifications()
   {
     DEBUG_PRINTF_P(PSTR("UDP notification from: %d.%d.%d.%d\n"), notifierUdp.remoteIP()[0], notifierUdp.remoteIP()[1], notifierUdp.remoteIP()[2], notifierUdp.remoteIP()[3]);
     parseNotifyPacket(udpIn);
-    return;
+    return true;
   }
 
   if (receiveDirect) {
@@ -572,13 +676,13 @@ void handleNotifications()
       //if the number of LEDs in your installation doesn't allow that, please include padding bytes at the end of the last packet
       byte tpmType = udpIn[1];
       if (tpmType == 0xaa) { //TPM2.NET polling, expect answer
-        sendTPM2Ack(); return;
+        sendTPM2Ack(); return true;
       }
-      if (tpmType != 0xda) return; //return if notTPM2.NET data
+      if (tpmType != 0xda) return true; //return if notTPM2.NET data
 
       realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_TPM2NET);
-      if (realtimeOverride) return;
+      if (realtimeOverride) return true;
 
       tpmPacketCount++; //increment the packet count
       if (tpmPacketCount == 1) tpmPayloadFrameSize = (udpIn[2] << 8) + udpIn[3]; //save frame size for the whole payload if this is the first packet
@@ -586,60 +690,58 @@ void handleNotifications()
       byte numPackets = udpIn[5];
 
       unsigned id = (tpmPayloadFrameSize/3)*(packetNum-1); //start LED
-      unsigned totalLen = strip.getLengthTotal();
-      for (size_t i = 6; i < tpmPayloadFrameSize + 4U && id < totalLen; i += 3, id++) {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-      }
+      if (len > 6) setRealtimePixels(id, udpIn + 6, min(unsigned(tpmPayloadFrameSize), len - 6)/3, 3);
       if (tpmPacketCount == numPackets) { //reset packet count and show if all packets were received
         tpmPacketCount = 0;
         if (useMainSegmentOnly) strip.trigger();
         else                    strip.show();
       }
-      return;
+      return true;
     }
 
     //UDP realtime: 1 warls 2 drgb 3 drgbw 4 dnrgb 5 dnrgbw
     if (udpIn[0] > 0 && udpIn[0] < 6) {
       realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
       DEBUG_PRINTLN(realtimeIP);
-      if (packetSize < 2) return;
+      if (packetSize < 2) return true;
 
       if (udpIn[1] == 0) {
         realtimeTimeout = 0; // cancel realtime mode immediately
-        return;
+        return true;
       } else {
         realtimeLock(udpIn[1]*1000 +1, REALTIME_MODE_UDP);
       }
-      if (realtimeOverride) return;
+      if (realtimeOverride) return true;
 
-      unsigned totalLen = strip.getLengthTotal();
-      if (udpIn[0] == 1 && packetSize > 5) { //warls
-        for (size_t i = 2; i < packetSize -3; i += 4) {
+      if (udpIn[0] == 1) { //warls, LEDs are addressed individually so every packet is shown
+        if (packetSize > 5) for (size_t i = 2; i < packetSize -3; i += 4) {
           setRealtimePixel(udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3], 0);
         }
-      } else if (udpIn[0] == 2 && packetSize > 4) { //drgb
-        for (size_t i = 2, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++)
-          {
-            setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-          }
+        showRealtimeFrame();
+        return true;
+      }
+      if (udpIn[0] == 2 && packetSize > 4) { //drgb
+        unsigned n = (packetSize - 2) / 3;
+        beginRealtimeRange(0, n);
+        setRealtimePixels(0, udpIn + 2, n, 3);
       } else if (udpIn[0] == 3 && packetSize > 6) { //drgbw
-          for (size_t i = 2, id = 0; i < packetSize -3 && id < totalLen; i += 4, id++) {
-            setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-          }
-      } else if (udpIn[0] == 4 && packetSize > 7) { //dnrgb
-        unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-        for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 3, id++) {
-          setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
+        unsigned n = (packetSize - 2) / 4;
+        beginRealtimeRange(0, n);
+        setRealtimePixels(0, udpIn + 2, n, 4);
+      } else if (udpIn[0] == 4 || udpIn[0] == 5) { //dnrgb, dnrgbw
+        if (packetSize == 4) { // header without LED data: frame sync
+          if (rtFrame.ranges) showRealtimeFrame();
+          return true;
         }
-      } else if (udpIn[0] == 5 && packetSize > 8) { //dnrgbw
+        const unsigned channels = udpIn[0] == 5 ? 4 : 3;
+        if (packetSize < 4 + channels) return true;
         unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-        for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 4, id++) {
-          setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-        }
+        unsigned n = (packetSize - 4) / channels;
+        beginRealtimeRange(id, n);
+        setRealtimePixels(id, udpIn + 4, n, channels);
       }
-      if (useMainSegmentOnly) strip.trigger();
-      else                    strip.show();
-      return;
+      endRealtimeRange();
+      return true;
     }
   }
 
@@ -660,6 +762,7 @@ void handleNotifications()
   }
 
   UsermodManager::onUdpPacket(udpIn, packetSize);
+  return true;
 }
 
 
@@ -669,6 +772,20 @@ void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
   strip.setRealtimePixelColor(pix, RGBW32(r,g,b,w));
 }
 
+// converts a whole packet of count RGB/RGBW tuples starting at LED start (before arlsOffset is applied)
+void setRealtimePixels(unsigned start, const uint8_t *data, unsigned count, unsigned channels)
+{
+  int pix = int(start) + arlsOffset;
+  if (pix < 0) { // negative offset: skip LEDs that fall before the strip start
+    unsigned skip = -pix;
+    if (skip >= count) return;
+    data  += skip * channels;
+    count -= skip;
+    pix = 0;
+  }
+  strip.setRealtimePixels(pix, data, count, channels);
+}
+
 /*********************************************************************************************\
    Refresh aging for remote units, drop if too old...
 \*********************************************************************************************/
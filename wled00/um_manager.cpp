@@ -22,7 +22,6 @@ static size_t getCount() {
 void UsermodManager::setup()             { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->setup(); }
 void UsermodManager::connected()         { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->connected(); }
 void UsermodManager::loop()              { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->loop();  }
-void UsermodManager::handleOverlayDraw() { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->handleOverlayDraw(); }
 void UsermodManager::appendConfigData(Print& dest)  { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->appendConfigData(dest); }
 bool UsermodManager::handleButton(uint8_t b) {
   bool overrideIO = false;
@@ -89,6 +88,22 @@ Usermod* UsermodManager::lookup(uint16_t mod_id) {
 
 size_t UsermodManager::getModCount() { return getCount(); };
 
+// usermods that do not implement handleOverlayDraw() run the default Usermod::handleOverlayDraw() which sets overlayUnused
+static bool overlayUnused = false;
+static bool overlayDrawn  = false;  // a usermod drew in the last handleOverlayDraw() pass
+void UsermodManager::handleOverlayDraw() {
+  bool drawn = false;
+  for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) {
+    overlayUnused = false;
+    (*mod)->handleOverlayDraw();
+    drawn |= !overlayUnused;
+  }
+  overlayDrawn = drawn;
+}
+bool UsermodManager::hasOverlay() { return overlayDrawn; }
+
+void Usermod::handleOverlayDraw() { overlayUnused = true; }
+
 /* Usermod v2 interface shim for oappend */
 Print* Usermod::oappend_shim = nullptr;
 
@@ -434,19 +434,20 @@ typedef enum UM_SoundSimulations {
 
 um_data_t* simulateSound(uint8_t simulationId)
 {
-  static uint8_t samplePeak;
-  static float   FFT_MajorPeak;
-  static uint8_t maxVol;
-  static uint8_t binNum;
+  // simulated data is kept per render task (WLED_ENABLE_PARALLEL_RENDER) as effects read it after the call
+  static WLED_RENDER_LOCAL uint8_t samplePeak;
+  static WLED_RENDER_LOCAL float   FFT_MajorPeak;
+  static WLED_RENDER_LOCAL uint8_t maxVol;
+  static WLED_RENDER_LOCAL uint8_t binNum;
 
-  static float    volumeSmth;
-  static uint16_t volumeRaw;
-  static float    my_magnitude;
+  static WLED_RENDER_LOCAL float    volumeSmth;
+  static WLED_RENDER_LOCAL uint16_t volumeRaw;
+  static WLED_RENDER_LOCAL float    my_magnitude;
 
   //arrays
   uint8_t *fftResult;
 
-  static um_data_t* um_data = nullptr;
+  static WLED_RENDER_LOCAL um_data_t* um_data = nullptr;
 
   if (!um_data) {
     //claim storage for arrays
@@ -614,6 +615,10 @@ uint32_t hashInt(uint32_t s) {
   return (s >> 16) ^ s;
 }
 
+#ifdef WLED_ENABLE_DETERMINISTIC_RNG
+WLED_RENDER_LOCAL uint32_t hwRndState = 0;
+#endif
+
 // 32 bit random number generator, inlining uses more code, use hw_random16() if speed is critical (see fcn_declare.h)
 uint32_t hw_random(uint32_t upperlimit) {
   uint32_t rnd = hw_random();
@@ -644,6 +649,156 @@ int32_t hw_random(int32_t lowerlimit, int32_t upperlimit) {
   #endif
 #endif
 
+// allocation telemetry
+// live allocations are kept in a small table (no per-buffer header) so that freed bytes can be attributed to their region and tag
+// allocations that do not fit into the table are only counted as untracked
+#ifndef WLED_ALLOC_TRACK_SLOTS
+  #ifdef ESP8266
+  #define WLED_ALLOC_TRACK_SLOTS 48
+  #else
+  #define WLED_ALLOC_TRACK_SLOTS 128
+  #endif
+#endif
+
+typedef struct {
+  const void *ptr;
+  uint32_t    size   : 24;
+  uint32_t    region : 2;
+  uint32_t    tag    : 6;
+} alloc_slot_t;
+
+static alloc_slot_t  allocSlots[WLED_ALLOC_TRACK_SLOTS];
+static alloc_stats_t allocRegions[ALLOC_REGIONS];
+static alloc_stats_t allocTags[ALLOC_TAGS];
+static uint32_t      allocUntracked = 0;
+static uint32_t      allocSnapshot[ALLOC_TAGS];  // live bytes per tag at last snapshotAllocations()
+static uint32_t      allocSnapshotTime = 0;
+static uint32_t      allocSnapshotHeap = 0;
+#ifdef ARDUINO_ARCH_ESP32
+// async web/MQTT callbacks (and render tasks) allocate concurrently with the loop task
+static portMUX_TYPE  allocMux = portMUX_INITIALIZER_UNLOCKED;
+struct AllocLock {
+  AllocLock()  { portENTER_CRITICAL(&allocMux); }
+  ~AllocLock() { portEXIT_CRITICAL(&allocMux); }
+};
+#define ALLOC_LOCK() const AllocLock lock
+#else
+#define ALLOC_LOCK() // ESP8266 async callbacks do not preempt the loop
+#endif
+
+static uint8_t allocRegion(const void *ptr) {
+  #ifndef ESP8266
+  if ((uintptr_t)ptr > SOC_DRAM_LOW && (uintptr_t)ptr < SOC_DRAM_HIGH) return ALLOC_REGION_DRAM;
+  #ifndef CONFIG_IDF_TARGET_ESP32C3
+  if ((uintptr_t)ptr > SOC_EXTRAM_DATA_LOW && (uintptr_t)ptr < SOC_EXTRAM_DATA_HIGH) return ALLOC_REGION_PSRAM;
+  #endif
+  return ALLOC_REGION_IRAM;
+  #else
+  return ALLOC_REGION_DRAM;
+  #endif
+}
+
+static void allocStatsAdd(alloc_stats_t &stats, size_t size) {
+  stats.live += size;
+  if (stats.live > stats.peak) stats.peak = stats.live;
+  stats.allocs++;
+}
+
+static void allocStatsSub(alloc_stats_t &stats, size_t size) {
+  stats.live = stats.live > size ? stats.live - size : 0;
+}
+
+static alloc_slot_t *findAllocSlot(const void *ptr) {
+  for (auto &slot : allocSlots) if (slot.ptr == ptr) return &slot;
+  return nullptr;
+}
+
+// region is the preferred region of the allocation function, used to account failures
+static void *trackAlloc(void *buffer, size_t size, uint8_t region, uint8_t tag = ALLOC_TAG_OTHER) {
+  ALLOC_LOCK();
+  if (!buffer) {
+    allocRegions[region].fails++;
+    allocTags[tag].fails++;
+    return nullptr;
+  }
+  alloc_slot_t *slot = findAllocSlot(nullptr);
+  if (!slot) {
+    allocUntracked++;
+    return buffer;
+  }
+  slot->ptr    = buffer;
+  slot->size   = size;
+  slot->region = allocRegion(buffer);
+  slot->tag    = tag;
+  allocStatsAdd(allocRegions[slot->region], size);
+  allocStatsAdd(allocTags[tag], size);
+  return buffer;
+}
+
+// returns tag of the released buffer
+static uint8_t untrackAlloc(const void *ptr) {
+  ALLOC_LOCK();
+  alloc_slot_t *slot = ptr ? findAllocSlot(ptr) : nullptr;
+  if (!slot) return ALLOC_TAG_OTHER;
+  allocStatsSub(allocRegions[slot->region], slot->size);
+  allocStatsSub(allocTags[slot->tag], slot->size);
+  slot->ptr = nullptr;
+  return slot->tag;
+}
+
+void *tagAllocation(void *ptr, uint8_t tag) {
+  ALLOC_LOCK();
+  alloc_slot_t *slot = ptr && tag < ALLOC_TAGS ? findAllocSlot(ptr) : nullptr;
+  if (slot && slot->tag != tag) {
+    allocStatsSub(allocTags[slot->tag], slot->size);
+    if (allocTags[slot->tag].allocs) allocTags[slot->tag].allocs--;
+    allocStatsAdd(allocTags[tag], slot->size);
+    slot->tag = tag;
+  }
+  return ptr;
+}
+
+void snapshotAllocations() {
+  for (unsigned t = 0; t < ALLOC_TAGS; t++) allocSnapshot[t] = allocTags[t].live;
+  allocSnapshotTime = millis();
+  allocSnapshotHeap = getFreeHeapSize();
+}
+
+static void serializeAllocStats(JsonArray arr, const alloc_stats_t &stats) {
+  arr.add(stats.live);
+  arr.add(stats.peak);
+  arr.add(stats.allocs);
+  arr.add(stats.fails);
+}
+
+// {"dram":[live,peak,allocs,fails],"psram":[..],"iram":[..],"tags":{"segpx":[..],..},"untracked":n,"json":bytes,"free":bytes,"maxblk":bytes,"frag":%,"purge":{..}}
+void serializeAllocations(JsonObject root) {
+  static const char tagNames[ALLOC_TAGS][8] PROGMEM = {"other", "segpx", "segdata", "segname", "trans", "frame", "cct", "ledmap", "segmap", "pallut"};
+  serializeAllocStats(root.createNestedArray(F("dram")), allocRegions[ALLOC_REGION_DRAM]);
+  #if defined(BOARD_HAS_PSRAM)
+  serializeAllocStats(root.createNestedArray(F("psram")), allocRegions[ALLOC_REGION_PSRAM]);
+  #endif
+  #ifndef ESP8266
+  serializeAllocStats(root.createNestedArray(F("iram")), allocRegions[ALLOC_REGION_IRAM]);
+  #endif
+  JsonObject tags = root.createNestedObject(F("tags"));
+  for (unsigned t = 0; t < ALLOC_TAGS; t++) serializeAllocStats(tags.createNestedArray(FPSTR(tagNames[t])), allocTags[t]);
+  root[F("untracked")] = allocUntracked;
+  root[F("json")] = pDoc ? pDoc->capacity() : 0; // global JSON buffer is allocated once at boot
+  size_t freeHeap = getFreeHeapSize();
+  size_t maxBlock = getContiguousFreeHeap();
+  root[F("free")] = freeHeap;
+  root[F("maxblk")] = maxBlock;
+  root[F("frag")] = freeHeap ? 100 - (maxBlock * 100) / freeHeap : 0; // fragmentation in %
+  if (allocSnapshotTime) {
+    JsonObject purge = root.createNestedObject(F("purge"));
+    purge["t"] = allocSnapshotTime;
+    purge[F("free")] = allocSnapshotHeap;
+    JsonObject live = purge.createNestedObject(F("tags"));
+    for (unsigned t = 0; t < ALLOC_TAGS; t++) live[FPSTR(tagNames[t])] = allocSnapshot[t];
+  }
+}
+
 // memory allocation functions with minimum free heap size check
 #ifdef ESP8266
 static void *validateFreeHeap(void *buffer) {
@@ -655,15 +810,19 @@ static void *validateFreeHeap(void *buffer) {
   return buffer;
 }
 
-void *d_malloc(size_t size) {
+static void *dramAlloc(size_t size) {
   // note: using "if (getContiguousFreeHeap() > MIN_HEAP_SIZE + size)" did perform worse in tests with regards to keeping heap healthy and UI working
   void *buffer = malloc(size);
   return validateFreeHeap(buffer);
 }
 
+void *d_malloc(size_t size) {
+  return trackAlloc(dramAlloc(size), size, ALLOC_REGION_DRAM);
+}
+
 void *d_calloc(size_t count, size_t size) {
   void *buffer = calloc(count, size);
-  return validateFreeHeap(buffer);
+  return trackAlloc(validateFreeHeap(buffer), count * size, ALLOC_REGION_DRAM);
 }
 
 // realloc with malloc fallback, note: on ESPS8266 there is no safe way to ensure MIN_HEAP_SIZE during realloc()s, free buffer and allocate new one
@@ -673,8 +832,14 @@ void *d_realloc_malloc(void *ptr, size_t size) {
   //if (buffer) return buffer; // realloc successful
   //d_free(ptr); // free old buffer if realloc failed (or min heap was exceeded)
   //return d_malloc(size); // fallback to malloc
+  uint8_t tag = untrackAlloc(ptr);
+  free(ptr);
+  return tagAllocation(d_malloc(size), tag);
+}
+
+void d_free(void *ptr) {
+  untrackAlloc(ptr);
   free(ptr);
-  return d_malloc(size);
 }
 #else
 static void *validateFreeHeap(void *buffer) {
@@ -687,7 +852,7 @@ static void *validateFreeHeap(void *buffer) {
   return buffer;
 }
 
-void *d_malloc(size_t size) {
+static void *dramAlloc(size_t size) {
   void *buffer;
   #if defined(CONFIG_IDF_TARGET_ESP32C3) || defined(CONFIG_IDF_TARGET_ESP32S2) || defined(CONFIG_IDF_TARGET_ESP32S3)
   // the newer ESP32 variants have byte-accessible fast RTC memory that can be used as heap, access speed is on-par with DRAM
@@ -706,6 +871,10 @@ void *d_malloc(size_t size) {
   return buffer;
 }
 
+void *d_malloc(size_t size) {
+  return trackAlloc(dramAlloc(size), size, ALLOC_REGION_DRAM);
+}
+
 void *d_calloc(size_t count, size_t size) {
   void *buffer = d_malloc(count * size);
   if (buffer) memset(buffer, 0, count * size); // clear allocated buffer
@@ -715,19 +884,29 @@ void *d_calloc(size_t count, size_t size) {
 // realloc with malloc fallback, original buffer is freed if realloc fails but not copied!
 void *d_realloc_malloc(void *ptr, size_t size) {
   void *buffer = heap_caps_realloc(ptr, size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  uint8_t tag = buffer ? untrackAlloc(ptr) : ALLOC_TAG_OTHER;
   buffer = validateFreeHeap(buffer);
-  if (buffer) return buffer; // realloc successful
+  if (buffer) return trackAlloc(buffer, size, ALLOC_REGION_DRAM, tag); // realloc successful
   d_free(ptr); // free old buffer if realloc failed (or min heap was exceeded)
-  return d_malloc(size); // fallback to malloc
+  return tagAllocation(d_malloc(size), tag); // fallback to malloc
+}
+
+void d_free(void *ptr) {
+  untrackAlloc(ptr);
+  heap_caps_free(ptr);
 }
 
 #ifdef BOARD_HAS_PSRAM
 // p_xalloc: prefer PSRAM, use DRAM as fallback
-void *p_malloc(size_t size) {
+static void *psramAlloc(size_t size) {
   void *buffer = heap_caps_malloc_prefer(size, 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
   return validateFreeHeap(buffer);
 }
 
+void *p_malloc(size_t size) {
+  return trackAlloc(psramAlloc(size), size, ALLOC_REGION_PSRAM);
+}
+
 void *p_calloc(size_t count, size_t size) {
   void *buffer = p_malloc(count * size);
   if (buffer) memset(buffer, 0, count * size); // clear allocated buffer
@@ -737,9 +916,10 @@ void *p_calloc(size_t count, size_t size) {
 // realloc with malloc fallback, original buffer is freed if realloc fails but not copied!
 void *p_realloc_malloc(void *ptr, size_t size) {
   void *buffer = heap_caps_realloc(ptr, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
-  if (buffer) return buffer; // realloc successful
+  if (buffer) return trackAlloc(buffer, size, ALLOC_REGION_PSRAM, untrackAlloc(ptr)); // realloc successful
+  uint8_t tag = untrackAlloc(ptr);
   p_free(ptr); // free old buffer if realloc failed
-  return p_malloc(size); // fallback to malloc
+  return tagAllocation(p_malloc(size), tag); // fallback to malloc
 }
 #endif
 #endif
@@ -749,6 +929,7 @@ void *p_realloc_malloc(void *ptr, size_t size) {
 // if multiple conflicting types are defined, the lowest bits of "type" take priority (see fcn_declare.h for types)
 void *allocate_buffer(size_t size, uint32_t type) {
   void *buffer = nullptr;
+  uint8_t region = ALLOC_REGION_DRAM; // region that was attempted first, failures are accounted to it
   #ifdef CONFIG_IDF_TARGET_ESP32
   // only classic ESP32 has "32bit accessible only" aka IRAM type. Using it frees up normal DRAM for other purposes
   // this memory region is used for IRAM_ATTR functions, whatever is left is unused and can be used for pixel buffers
@@ -757,33 +938,40 @@ void *allocate_buffer(size_t size, uint32_t type) {
     // prefer 32bit region, then PSRAM, fallback to any heap. Note: if adding "INTERNAL"-flag this wont work
     buffer = heap_caps_malloc_prefer(size, 3, MALLOC_CAP_32BIT, MALLOC_CAP_SPIRAM, MALLOC_CAP_8BIT);
     buffer = validateFreeHeap(buffer);
+    region = ALLOC_REGION_IRAM;
   }
   else
   #endif
   #if !defined(BOARD_HAS_PSRAM)
-  buffer = d_malloc(size);
+  buffer = dramAlloc(size);
   #else
   if (type & BFRALLOC_PREFER_DRAM) {
-    if (getContiguousFreeHeap() < 3*(MIN_HEAP_SIZE/2) + size && size > PSRAM_THRESHOLD)
-      buffer = p_malloc(size); // prefer PSRAM for large allocations & when DRAM is low
-    else
-      buffer = d_malloc(size); // allocate in DRAM if enough free heap is available, PSRAM as fallback
+    if (getContiguousFreeHeap() < 3*(MIN_HEAP_SIZE/2) + size && size > PSRAM_THRESHOLD) {
+      buffer = psramAlloc(size); // prefer PSRAM for large allocations & when DRAM is low
+      region = ALLOC_REGION_PSRAM;
+    } else
+      buffer = dramAlloc(size); // allocate in DRAM if enough free heap is available, PSRAM as fallback
   }
   else if (type & BFRALLOC_ENFORCE_DRAM)
     buffer = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT); // use DRAM only, otherwise return nullptr
   else if (type & BFRALLOC_PREFER_PSRAM) {
     // if DRAM is plenty, prefer it over PSRAM for speed, reserve enough DRAM for segment data: if MAX_SEGMENT_DATA is exceeded, always uses PSRAM
     if (getContiguousFreeHeap() > 4*MIN_HEAP_SIZE + size + ((uint32_t)(MAX_SEGMENT_DATA - Segment::getUsedSegmentData())))
-      buffer = d_malloc(size);
-    else
-      buffer = p_malloc(size); // prefer PSRAM
+      buffer = dramAlloc(size);
+    else {
+      buffer = psramAlloc(size); // prefer PSRAM
+      region = ALLOC_REGION_PSRAM;
+    }
   }
-  else if (type & BFRALLOC_ENFORCE_PSRAM)
+  else if (type & BFRALLOC_ENFORCE_PSRAM) {
     buffer = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT); // use PSRAM only, otherwise return nullptr
+    region = ALLOC_REGION_PSRAM;
+  }
   buffer = validateFreeHeap(buffer);
   #endif
   if (buffer && (type & BFRALLOC_CLEAR))
     memset(buffer, 0, size); // clear allocated buffer
+  trackAlloc(buffer, size, region, (type >> 24) % ALLOC_TAGS);
   /*
   #if !defined(ESP8266) && defined(WLED_DEBUG)
   if (buffer) {
@@ -47,26 +47,25 @@ void WLED::loop()
   size_t               loopDelay = loopMillis - lastRun;
   if (lastRun == 0) loopDelay=0; // startup - don't have valid data from last run.
   if (loopDelay > 2) DEBUG_PRINTF_P(PSTR("Loop delayed more than %ums.\n"), loopDelay);
-  static unsigned long maxLoopMillis = 0;
-  static size_t        avgLoopMillis = 0;
-  static unsigned long maxUsermodMillis = 0;
-  static size_t        avgUsermodMillis = 0;
-  static unsigned long maxStripMillis = 0;
-  static size_t        avgStripMillis = 0;
-  unsigned long        stripMillis;
 #endif
+  profileLoopStart();
 
   handleTime();
   #ifndef WLED_DISABLE_INFRARED
+  profileLap(PROF_OTHER);
   handleIR();        // 2nd call to function needed for ESP32 to return valid results -- should be good for ESP8266, too
+  profileLap(PROF_IR);
   #endif
   handleConnection();
   #ifdef WLED_ENABLE_ADALIGHT
   handleSerial();
   #endif
   handleImprovWifiScan();
+  profileLap(PROF_OTHER);
   handleNotifications();
+  profileLap(PROF_NOTIFICATIONS);
   handleTransitions();
+  profileLap(PROF_TRANSITIONS);
   #ifdef WLED_ENABLE_DMX
   handleDMXOutput();
   #endif
@@ -74,21 +73,17 @@ void WLED::loop()
   dmxInput.update();
   #endif
 
-  #ifdef WLED_DEBUG
-  unsigned long usermodMillis = millis();
-  #endif
+  profileLap(PROF_OTHER);
   userLoop();
   UsermodManager::loop();
-  #ifdef WLED_DEBUG
-  usermodMillis = millis() - usermodMillis;
-  avgUsermodMillis += usermodMillis;
-  if (usermodMillis > maxUsermodMillis) maxUsermodMillis = usermodMillis;
-  #endif
+  profileLap(PROF_USERMODS);
 
   yield();
   handleIO();
   #ifndef WLED_DISABLE_INFRARED
+  profileLap(PROF_OTHER);
   handleIR();
+  profileLap(PROF_IR);
   #endif
   #ifndef WLED_DISABLE_ESPNOW
   handleRemote();
@@ -102,9 +97,6 @@ void WLED::loop()
     yield();
   }
 
-  #ifdef WLED_DEBUG
-  stripMillis = millis();
-  #endif
   if (!realtimeMode || realtimeOverride || (realtimeMode && useMainSegmentOnly))  // block stuff if WARLS/Adalight is enabled
   {
     if (apActive) dnsServer.processNextRequest();
@@ -115,29 +107,33 @@ void WLED::loop()
     yield();
 
     #ifndef WLED_DISABLE_HUESYNC
+    profileLap(PROF_OTHER);
     handleHue();
+    profileLap(PROF_HUE);
     yield();
     #endif
 
     if (!presetNeedsSaving()) {
+      profileLap(PROF_OTHER);
       handlePlaylist();
+      profileLap(PROF_PLAYLIST);
       yield();
     }
+    profileLap(PROF_OTHER);
     handlePresets();
+    profileLap(PROF_PRESETS);
     yield();
 
-    if (!offMode || strip.isOffRefreshRequired() || strip.needsUpdate())
+    if ((!offMode || strip.isOffRefreshRequired() || strip.needsUpdate()) && !strip.isIdle()) { // static frame needs no service
+      profileLap(PROF_OTHER);
       strip.service();
+      profileLap(PROF_STRIP);
+    }
     #ifdef ESP8266
     else if (!noWifiSleep)
       delay(1); //required to make sure ESP enters modem sleep (see #1184)
     #endif
   }
-  #ifdef WLED_DEBUG
-  stripMillis = millis() - stripMillis;
-  avgStripMillis += stripMillis;
-  if (stripMillis > maxStripMillis) maxStripMillis = stripMillis;
-  #endif
 
   yield();
 #ifdef ESP8266
@@ -154,7 +150,9 @@ void WLED::loop()
   if (millis() - lastMqttReconnectAttempt > 30000 || lastMqttReconnectAttempt == 0) { // lastMqttReconnectAttempt==0 forces immediate broadcast
     lastMqttReconnectAttempt = millis();
     #ifndef WLED_DISABLE_MQTT
+    profileLap(PROF_OTHER);
     initMqtt();
+    profileLap(PROF_MQTT);
     #endif
     yield();
     // refresh WLED nodes list
@@ -172,6 +170,7 @@ void WLED::loop()
   // reconnect WiFi to clear stale allocations if heap gets too low
   if (millis() - heapTime > 15000) {
     uint32_t heap = getFreeHeapSize();
+    if (heap < MIN_HEAP_SIZE) snapshotAllocations(); // remember what filled the heap (see /json/info "alloc")
     if (heap < MIN_HEAP_SIZE && lastHeap < MIN_HEAP_SIZE) {
       DEBUG_PRINTF_P(PSTR("Heap too low! %u\n"), heap);
       forceReconnect = true;
@@ -196,6 +195,7 @@ void WLED::loop()
     BusManager::setBrightness(scaledBri(bri)); // fix re-initialised bus' brightness #4005 and #4824
     configNeedsWrite = true;
   }
+  BusManager::updateColorOrderMap(); // apply color order map changes from settings (strip is not outputting here)
   if (loadLedmap >= 0) {
     strip.deserializeMap(loadLedmap);
     loadLedmap = -1;
@@ -204,7 +204,9 @@ void WLED::loop()
   if (configNeedsWrite) serializeConfigToFS();
 
   yield();
+  profileLap(PROF_OTHER);
   handleWs();
+  profileLap(PROF_WS);
 #if defined(STATUSLED)
   handleStatusLED();
 #endif
@@ -227,16 +229,10 @@ void WLED::loop()
   if (doReboot && (!doInitBusses || !configNeedsWrite)) // if busses have to be inited & saved, wait until next iteration
     reset();
 
+  profileLoopEnd();
+
 // DEBUG serial logging (every 30s)
 #ifdef WLED_DEBUG
-  loopMillis = millis() - loopMillis;
-  if (loopMillis > 30) {
-    DEBUG_PRINTF_P(PSTR("Loop took %lums.\n"), loopMillis);
-    DEBUG_PRINTF_P(PSTR("Usermods took %lums.\n"), usermodMillis);
-    DEBUG_PRINTF_P(PSTR("Strip took %lums.\n"), stripMillis);
-  }
-  avgLoopMillis += loopMillis;
-  if (loopMillis > maxLoopMillis) maxLoopMillis = loopMillis;
   if (millis() - debugTime > 29999) {
     DEBUG_PRINTLN(F("---DEBUG INFO---"));
     DEBUG_PRINTF_P(PSTR("Runtime: %lu\n"),  millis());
@@ -287,19 +283,13 @@ void WLED::loop()
     DEBUG_PRINTF_P(PSTR("Client IP: %u.%u.%u.%u\n"), Network.localIP()[0], Network.localIP()[1], Network.localIP()[2], Network.localIP()[3]);
     if (loops > 0) { // avoid division by zero
       DEBUG_PRINTF_P(PSTR("Loops/sec: %u\n"),         loops / 30);
-      DEBUG_PRINTF_P(PSTR("Loop time[ms]: %u/%lu\n"), avgLoopMillis/loops,    maxLoopMillis);
-      DEBUG_PRINTF_P(PSTR("UM time[ms]: %u/%lu\n"),   avgUsermodMillis/loops, maxUsermodMillis);
-      DEBUG_PRINTF_P(PSTR("Strip time[ms]:%u/%lu\n"), avgStripMillis/loops,   maxStripMillis);
+      DEBUG_PRINTF_P(PSTR("Loop time[us]: %u/%u\n"),  getLoopProfile(PROF_LOOP).avg,     getLoopProfile(PROF_LOOP).max);
+      DEBUG_PRINTF_P(PSTR("UM time[us]: %u/%u\n"),    getLoopProfile(PROF_USERMODS).avg, getLoopProfile(PROF_USERMODS).max);
+      DEBUG_PRINTF_P(PSTR("Strip time[us]: %u/%u\n"), getLoopProfile(PROF_STRIP).avg,    getLoopProfile(PROF_STRIP).max);
     }
     strip.printSize();
     server.printStatus(DEBUGOUT);
     loops = 0;
-    maxLoopMillis = 0;
-    maxUsermodMillis = 0;
-    maxStripMillis = 0;
-    avgLoopMillis = 0;
-    avgUsermodMillis = 0;
-    avgStripMillis = 0;
     debugTime = millis();
   }
   loops++;
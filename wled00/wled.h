@@ -459,6 +459,9 @@ WLED_GLOBAL byte alexaNumPresets _INIT(0);                        // number of p
 
 WLED_GLOBAL uint16_t realtimeTimeoutMs _INIT(2500);               // ms timeout of realtime mode before returning to normal mode
 WLED_GLOBAL int arlsOffset _INIT(0);                              // realtime LED offset
+WLED_GLOBAL uint16_t udpFrameLeds _INIT(0);                       // LEDs per UDP realtime frame, shown once all have arrived (0 = learn from previous frames)
+WLED_GLOBAL uint8_t udpFrameTimeoutMs _INIT(20);                  // ms to wait for missing packets/universes of a UDP realtime or E1.31/Art-Net frame before showing it anyway
+WLED_GLOBAL uint16_t udpRxBudgetUs _INIT(4000);                   // max. time (us) spent draining queued UDP packets per loop pass (at least one packet is processed)
 WLED_GLOBAL bool arlsDisableGammaCorrection _INIT(true);          // activate if gamma correction is handled by the source
 WLED_GLOBAL bool arlsForceMaxBri _INIT(false);                    // enable to force max brightness if source has very dark colors that would be black
 
@@ -495,6 +498,7 @@ WLED_GLOBAL uint16_t DMXSegmentSpacing _INIT(0);                  // Number of v
 WLED_GLOBAL byte e131LastSequenceNumber[E131_MAX_UNIVERSE_COUNT]; // to detect packet loss
 WLED_GLOBAL bool e131Multicast _INIT(false);                      // multicast or unicast
 WLED_GLOBAL bool e131SkipOutOfSequence _INIT(false);              // freeze instead of flickering
+WLED_GLOBAL uint8_t e131MinFrameMs _INIT(16);                     // min. ms between outputs of E1.31/Art-Net/DDP data (max. frame rate), 0 = unlimited; sync packets are not throttled
 WLED_GLOBAL uint16_t pollReplyCount _INIT(0);                     // count number of replies for ArtPoll node report
 
 // mqtt
@@ -837,6 +841,9 @@ WLED_GLOBAL IPAddress realtimeIP _INIT_N(((0, 0, 0, 0)));
 WLED_GLOBAL unsigned long realtimeTimeout _INIT(0);
 WLED_GLOBAL uint8_t tpmPacketCount _INIT(0);
 WLED_GLOBAL uint16_t tpmPayloadFrameSize _INIT(0);
+WLED_GLOBAL uint32_t udpRxPackets _INIT(0);                       // UDP packets received on notifier & Hyperion ports
+WLED_GLOBAL uint32_t udpRxDropped _INIT(0);                       // UDP packets discarded (oversized, malformed or realtime disabled)
+WLED_GLOBAL uint32_t udpRxLate _INIT(0);                          // loop passes that ran out of budget while UDP packets were still queued
 WLED_GLOBAL bool useMainSegmentOnly _INIT(false);
 WLED_GLOBAL bool realtimeRespectLedMaps _INIT(true);                     // Respect LED maps when receiving realtime data
 
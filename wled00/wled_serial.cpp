@@ -81,6 +81,25 @@ void handleSerial()
   while (Serial.available() > 0)
   {
     yield();
+    if (state == AdaState::Data_Red) {
+      // fast path: convert all complete RGB triplets already buffered by the UART in one go
+      constexpr unsigned ADA_CHUNK = 32; // pixels per bulk read
+      uint8_t buf[ADA_CHUNK*3];
+      unsigned n = min(unsigned(Serial.available()) / 3, min(unsigned(count), ADA_CHUNK));
+      if (n > 0) {
+        Serial.readBytes(buf, n*3);
+        if (!realtimeOverride) setRealtimePixels(pixel, buf, n, 3);
+        pixel += n;
+        count -= n;
+        continuousSendLED = false; // received bytes disable Continuous Serial Streaming
+        if (count == 0) {
+          realtimeLock(realtimeTimeoutMs, REALTIME_MODE_ADALIGHT);
+          if (!realtimeOverride) strip.show();
+          state = AdaState::Header_A;
+        }
+        continue;
+      }
+    }
     byte next = Serial.peek();
     switch (state) {
       case AdaState::Header_A:
@@ -190,6 +190,10 @@ static void handleUpload(AsyncWebServerRequest *request, const String& filename,
     request->_tempFile = WLED_FS.open(finalname, "w");
     DEBUG_PRINTF_P(PSTR("Uploading %s\n"), finalname.c_str());
     if (finalname.equals(FPSTR(getPresetsFileName()))) presetsModifiedTime = toki.second();
+    if (finalname.startsWith(F("/ledmap")) && finalname.endsWith(F(".json"))) {
+      finalname.replace(F(".json"), F(".bin"));
+      WLED_FS.remove(finalname); // compiled ledmap (see WS2812FX::deserializeMap()) is stale
+    }
   }
   if (len) {
     request->_tempFile.write(data,len);